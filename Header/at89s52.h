@@ -15,6 +15,11 @@
 
 /*------------------------------Byte and Bit addressable SFRs--------------------------------------------*/
 
+#ifdef AT89S52_HOST
+/* gcc/clang build, SFRs map to the emulated register file in at89s52_host.c */
+#include "at89s52_host.h"
+#else
+
 /* BYTE addressable registers */
 __sfr __at 0x80 P0;
 __sfr __at 0x81 SP;
@@ -154,11 +159,17 @@ __sbit __at 0xD4 RS1;
 __sbit __at 0xD5 F0;
 __sbit __at 0xD6 AC;
 __sbit __at 0xD7 CY;
+#endif // AT89S52_HOST
 
 /*----------------------------------------General Macros--------------------------------------------------*/
 #define ENABLE 1
 #define DISABLE 0
 
+/* Body of busy-wait loops that poll RAM set by an ISR, the host backend steps the emulation here */
+#ifndef IDLE_POLL
+#define IDLE_POLL()
+#endif
+
 // GPIO general macros
 #define PORT0 0
 #define PORT1 1
@@ -187,11 +198,23 @@ __sbit __at 0xD7 CY;
 #define TIMER_MODE2 2
 #define TIMER_MODE3 3
 
+#define TIMER2_AUTO_RELOAD 0
+#define TIMER2_CAPTURE 1
+#define TIMER2_BAUD_RATE 2
+
 #define MS 0
 #define US 1
 
 /*------------------------------At89s52 Crystal Clock Frequency------------------------------------------*/
+#ifndef CLOCK_SOURCE
 #define CLOCK_SOURCE 12000000UL
+#endif
+
+/*------------------------------Timer allocation---------------------------------------------------------*/
+/* Timer owned by the system tick in at89s52_tick.c, T0 or T2 */
+#ifndef TICK_TIMER
+#define TICK_TIMER T2
+#endif
 
 /* Interrupt numbers: address = (number * 8) + 3 */
 #define INT0_VECTOR        0       /* 0x03 external interrupt 0 */
@@ -0,0 +1,97 @@
+#ifndef AT89S52_DEBOUNCE_H
+#define AT89S52_DEBOUNCE_H
+
+/*
+ * at89s52_debounce.h
+ * Description: This header file contains function declarations for at89s52_debounce.c file
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for the tick the sampling runs on
+#include "at89s52_tick.h"
+
+/* Ports that can be debounced, 8 pins each */
+#ifndef DEBOUNCE_MAX_PORTS
+#define DEBOUNCE_MAX_PORTS 2
+#endif
+
+/* Ticks between samples, a change is taken after 4 equal samples (20 ms at 5 x 1 ms) */
+#ifndef DEBOUNCE_TICKS
+#define DEBOUNCE_TICKS 5
+#endif
+
+#define DEBOUNCE_NONE 0xFF
+
+/*
+ *@fn        -   debounceInit
+ *
+ *@brief     -   Function to clear the channels and attach the sampling to the tick
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t, 0 if the tick has no free hook
+ */
+uint8_t debounceInit(void);
+
+/*
+ *@fn        -   debounceAdd
+ *
+ *@brief     -   Function to debounce pins of a port. The pins are made inputs and are
+ *               active low, a pressed button pulls its pin to ground
+ *
+ *@param[1]  -   GPIO ports selection
+ *@param[2]  -   Pins to debounce
+ *
+ *return     -   uint8_t, channel number or DEBOUNCE_NONE if all channels are used
+ */
+uint8_t debounceAdd(uint8_t port, uint8_t mask);
+
+/*
+ *@fn        -   debounceSample
+ *
+ *@brief     -   Function to take one sample of every channel. The 8 pins of a port are
+ *               debounced in parallel with 2 bit vertical counters, so the cost is the same
+ *               for 1 or 8 pins. Runs from the tick, call it directly only without debounceInit
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+void debounceSample(void);
+
+/*
+ *@fn        -   debounceState
+ *
+ *@brief     -   Function to get the debounced state of a channel, 1 for a pressed pin
+ *
+ *@param[1]  -   Channel number
+ *
+ *return     -   uint8_t
+ */
+uint8_t debounceState(uint8_t channel);
+
+/*
+ *@fn        -   debouncePressed
+ *
+ *@brief     -   Function to take the pins pressed since the last call
+ *
+ *@param[1]  -   Channel number
+ *
+ *return     -   uint8_t, pin mask
+ */
+uint8_t debouncePressed(uint8_t channel);
+
+/*
+ *@fn        -   debounceReleased
+ *
+ *@brief     -   Function to take the pins released since the last call
+ *
+ *@param[1]  -   Channel number
+ *
+ *return     -   uint8_t, pin mask
+ */
+uint8_t debounceReleased(uint8_t channel);
+
+#endif // AT89S52_DEBOUNCE_H
@@ -0,0 +1,80 @@
+#ifndef AT89S52_DS18B20_H
+#define AT89S52_DS18B20_H
+
+/*
+ * at89s52_ds18b20.h
+ * Description: This header file contains function declarations for at89s52_ds18b20.c file
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for the 1-Wire bus and its result codes
+#include "at89s52_onewire.h"
+
+/*
+ * Longest conversion time in milliseconds, 750 at the power-on 12 bit resolution. The
+ * conversion is timed with millis(), so tickInit() must have run.
+ */
+#ifndef DS18B20_CONVERT_MS
+#define DS18B20_CONVERT_MS 750
+#endif
+
+/*
+ * Define DS18B20_PARASITE when the sensors take their power from the data line. They can not
+ * answer read slots while converting then, and ds18b20Ready() waits out DS18B20_CONVERT_MS
+ * without touching the bus.
+ */
+
+/* Family code, first byte of the ROM code */
+#define DS18B20_FAMILY              0x28
+
+/* Function commands */
+#define DS18B20_CONVERT_T           0x44
+#define DS18B20_READ_SCRATCHPAD     0xBE
+
+/* Bytes in the scratchpad, the last one is the CRC-8 */
+#define DS18B20_SCRATCHPAD_SIZE     9
+
+/* Bit 7 of the configuration byte reads 0 and bits 4-0 read 1 on every resolution */
+#define DS18B20_CONFIG_FIXED_MASK   0x9F
+#define DS18B20_CONFIG_FIXED        0x1F
+
+/*
+ *@fn        -   ds18b20Start
+ *
+ *@brief     -   Function to start a temperature conversion and return at once
+ *
+ *@param[1]  -   ROM code of the sensor, 0 to start every sensor on the bus together
+ *
+ *return     -   uint8_t, ONEWIRE_OK or ONEWIRE_NO_DEVICE
+ */
+uint8_t ds18b20Start(const uint8_t *rom);
+
+/*
+ *@fn        -   ds18b20Ready
+ *
+ *@brief     -   Function to check from the main loop whether the conversion has finished.
+ *               Unless DS18B20_PARASITE is set it reads one slot, the sensors hold it low
+ *               while busy, so keep other traffic off the bus until this returns 1
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t, 1 when done or when no conversion is running
+ */
+uint8_t ds18b20Ready(void);
+
+/*
+ *@fn        -   ds18b20Read
+ *
+ *@brief     -   Function to read the last converted temperature from the scratchpad, a
+ *               scratchpad with a bad CRC or configuration byte is a ONEWIRE_CRC_ERROR
+ *
+ *@param[1]  -   ROM code of the sensor, 0 when it is the only device on the bus
+ *@param[2]  -   Reference to store the temperature in 1/16 degree Celsius
+ *
+ *return     -   uint8_t, ONEWIRE_OK, ONEWIRE_NO_DEVICE or ONEWIRE_CRC_ERROR
+ */
+uint8_t ds18b20Read(const uint8_t *rom, int16_t *temp);
+
+#endif // AT89S52_DS18B20_H
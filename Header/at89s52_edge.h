@@ -0,0 +1,141 @@
+#ifndef AT89S52_EDGE_H
+#define AT89S52_EDGE_H
+
+/*
+ * at89s52_edge.h
+ * Description: This header file contains function declarations for at89s52_edge.c file
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for the tick counter and timer the timestamps come from
+#include "at89s52_tick.h"
+
+/* Events the queue holds, must be a power of two and not more than 128 */
+#ifndef EDGE_QUEUE_SIZE
+#define EDGE_QUEUE_SIZE 8
+#endif
+
+/* Memory space of the queue, __idata or __xdata */
+#ifndef EDGE_QUEUE_SPACE
+#define EDGE_QUEUE_SPACE __idata
+#endif
+
+/* Set to 0 to leave a vector free for another driver */
+#ifndef EDGE_USE_INT0
+#define EDGE_USE_INT0 1
+#endif
+
+#ifndef EDGE_USE_INT1
+#define EDGE_USE_INT1 1
+#endif
+
+/*
+ * One falling edge. ticks and counts are the tick counter and the tick timer counts since the
+ * last tick, read at ISR entry, so the resolution is one machine cycle. Use edgeDelta() for
+ * intervals, ticks wraps after 65536 ticks.
+ */
+typedef struct
+{
+    uint8_t source;     // INT0_VECTOR or INT1_VECTOR
+    uint16_t ticks;
+    uint16_t counts;
+} edgeEvent_t;
+
+/*
+ *@fn        -   edgeInit
+ *
+ *@brief     -   Function to start capturing falling edges of an external interrupt pin.
+ *               Needs tickInit for the timestamps. Keep INTx at the priority of the tick
+ *               timer so the tick ISR cannot preempt the capture
+ *
+ *@param[1]  -   INT0_VECTOR or INT1_VECTOR
+ *
+ *return     -   void
+ */
+void edgeInit(uint8_t INTx);
+
+/*
+ *@fn        -   edgeStop
+ *
+ *@brief     -   Function to stop capturing an external interrupt pin, queued events stay
+ *
+ *@param[1]  -   INT0_VECTOR or INT1_VECTOR
+ *
+ *return     -   void
+ */
+void edgeStop(uint8_t INTx);
+
+/*
+ *@fn        -   edgeRead
+ *
+ *@brief     -   Function to take the oldest event from the queue, never blocks
+ *
+ *@param[1]  -   Reference to store the event
+ *
+ *return     -   uint8_t, 1 if an event was read else 0
+ */
+uint8_t edgeRead(edgeEvent_t *event);
+
+/*
+ *@fn        -   edgeAvailable
+ *
+ *@brief     -   Function to get the number of events waiting in the queue
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t
+ */
+uint8_t edgeAvailable(void);
+
+/*
+ *@fn        -   edgeOverflows
+ *
+ *@brief     -   Function to get the number of edges lost because the queue was full
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint16_t
+ */
+uint16_t edgeOverflows(void);
+
+/*
+ *@fn        -   edgeDelta
+ *
+ *@brief     -   Function to get the time between two events
+ *
+ *@param[1]  -   Earlier event
+ *@param[2]  -   Later event, less than 65536 ticks after the earlier one
+ *
+ *return     -   uint32_t, in microseconds
+ */
+uint32_t edgeDelta(const edgeEvent_t *from, const edgeEvent_t *to);
+
+#if EDGE_USE_INT0
+/*
+ *@fn        -   edgeInt0Isr
+ *
+ *@brief     -   INT0 interrupt service routine, queues a timestamped event
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+void edgeInt0Isr(void) __interrupt(INT0_VECTOR);
+#endif
+
+#if EDGE_USE_INT1
+/*
+ *@fn        -   edgeInt1Isr
+ *
+ *@brief     -   INT1 interrupt service routine, queues a timestamped event
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+void edgeInt1Isr(void) __interrupt(INT1_VECTOR);
+#endif
+
+#endif // AT89S52_EDGE_H
@@ -0,0 +1,49 @@
+#ifndef AT89S52_FORMAT_H
+#define AT89S52_FORMAT_H
+
+/*
+ * at89s52_format.h
+ * Description: This header file contains function declarations for at89s52_format.c file
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+/* Standard library for standard args */
+#include <stdarg.h>
+// Library for AT89S52 MCU, contains mnemounics for SFR's
+#include "at89s52.h"
+
+/* Receives every output character, e.g. serialTx */
+typedef void (*formatSink_t)(uint8_t c);
+
+/*
+ *@fn        -   formatPrint
+ *
+ *@brief     -   Function to format a string into a sink. Conversions are
+ *               %[-][0][width][.precision][l]{d,i,u,x,X,k,c,s,%}.
+ *               %k prints a fixed-point value with precision fraction digits,
+ *               e.g. %.2k of 1234 prints 12.34
+ *
+ *@param[1]  -   Function that takes each output character
+ *@param[2]  -   Format string
+ *@param[3]  -   For multiple parameters
+ *
+ *return     -   void
+ */
+void formatPrint(formatSink_t sink, const char *fmt, ...);
+
+/*
+ *@fn        -   formatPrintV
+ *
+ *@brief     -   Function to format a string into a sink from a va_list, see formatPrint
+ *
+ *@param[1]  -   Function that takes each output character
+ *@param[2]  -   Format string
+ *@param[3]  -   Argument list
+ *
+ *return     -   void
+ */
+void formatPrintV(formatSink_t sink, const char *fmt, va_list args);
+
+#endif // AT89S52_FORMAT_H
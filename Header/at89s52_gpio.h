@@ -12,6 +12,109 @@
 // Library for AT89S52 MCU, contains mnemounics for SFR's  
 #include "at89s52.h"
 
+/*
+ * Compile time pin handles.
+ * GPIO_PIN(P1, 3) names the __sbit P1_3 from at89s52.h, so the macros below compile to a
+ * single bit instruction when port and pin are constants:
+ *   GPIO_PIN_SET     -> SETB bit       (1 cycle, 2 bytes)
+ *   GPIO_PIN_CLEAR   -> CLR  bit       (1 cycle, 2 bytes)
+ *   GPIO_PIN_TOGGLE  -> CPL  bit       (1 cycle, 2 bytes)
+ *   GPIO_PIN_READ    -> MOV  C, bit    (1 cycle, 2 bytes)
+ * gpioPinWrite()/gpioPinToggle()/gpioPinRead() cost an LCALL, the mask shift and the port
+ * switch on every call. Use them when port or pin is only known at run time.
+ *
+ * Example:
+ *   #define LED GPIO_PIN(P1, 3)
+ *   GPIO_PIN_SET(LED);
+ */
+#define GPIO_PIN(port, pin)         port##_##pin
+
+#define GPIO_PIN_SET(pin)           ((pin) = 1)
+#define GPIO_PIN_CLEAR(pin)         ((pin) = 0)
+#define GPIO_PIN_TOGGLE(pin)        ((pin) = !(pin))
+#define GPIO_PIN_READ(pin)          ((pin) ? 1 : 0)
+#define GPIO_PIN_WRITE(pin, value)  ((pin) = (value) ? 1 : 0)
+
+/*
+ * Build with -DGPIO_USE_SHADOW to keep the intended output state of each port in an __data
+ * byte. The pin and port functions then change the shadow and store the whole byte with a
+ * single MOV, so the latch is never read back and a pin pulled low from outside cannot be
+ * latched low by a write to another pin.
+ * gpioShadowPinWrite() changes only the shadow and gpioShadowCommit() stores it, so several
+ * pins of one port switch at the same instant. With a constant port use the macros:
+ *   GPIO_SHADOW(P1) &= ~0x0C;     -> ANL direct, #data
+ *   GPIO_SHADOW_COMMIT(P1);       -> MOV P1, direct
+ * Do not write a shadowed port directly or with GPIO_PIN_*, the shadow would go stale.
+ * The functions and the GPIO_PORT_* macros below mask interrupts while they read, change and
+ * store a shadow, so an ISR may update the same port through the macros without either write
+ * being lost. The functions are not reentrant, an ISR uses the macros.
+ */
+#ifdef GPIO_USE_SHADOW
+
+extern __data uint8_t gpioShadowP0;
+extern __data uint8_t gpioShadowP1;
+extern __data uint8_t gpioShadowP2;
+extern __data uint8_t gpioShadowP3;
+
+#ifdef AT89S52_HOST
+/* Port names are register expressions on the host and cannot be pasted, look the shadow up instead */
+#define GPIO_SHADOW(port)           (*gpioHostShadow(&(port)))
+
+/*
+ *@fn        -   gpioHostShadow
+ *
+ *@brief     -   Function to get the shadow byte of a port from its emulated register
+ *
+ *@param[1]  -   Emulated port register
+ *
+ *return     -   __data uint8_t *
+ */
+__data uint8_t *gpioHostShadow(volatile uint8_t *sfr);
+#else
+#define GPIO_SHADOW(port)           gpioShadow##port
+#endif
+#define GPIO_SHADOW_COMMIT(port)    ((port) = GPIO_SHADOW(port))
+
+#endif // GPIO_USE_SHADOW
+
+/*
+ * Multi-pin updates on a constant port. Only the pins in the masks change and each of them
+ * changes once, so no pin passes through a wrong level on the way:
+ *   GPIO_PORT_SET_CLEAR(P2, 0x01, 0x06)      -> ANL P2, #0xF9 then ORL P2, #0x01
+ *   GPIO_PORT_WRITE_MASKED(P2, 0x0F, digit)  -> clear then set the low nibble
+ * With GPIO_USE_SHADOW they update the shadow and store the port with a single MOV, so all
+ * pins switch together. A bit in both set and clear ends up set.
+ */
+#ifdef GPIO_USE_SHADOW
+#define GPIO_PORT_SET_CLEAR(port, set, clr)                                            \
+    do {                                                                                \
+        uint8_t gpioEa = EA;                                                            \
+        EA = 0;                                                                         \
+        GPIO_SHADOW(port) = (GPIO_SHADOW(port) & (uint8_t)~(clr)) | (uint8_t)(set);     \
+        (port) = GPIO_SHADOW(port);                                                     \
+        EA = gpioEa;                                                                    \
+    } while (0)
+#define GPIO_PORT_WRITE_MASKED(port, mask, value)                                      \
+    do {                                                                                \
+        uint8_t gpioEa = EA;                                                            \
+        EA = 0;                                                                         \
+        GPIO_SHADOW(port) = (GPIO_SHADOW(port) & (uint8_t)~(mask)) | (uint8_t)((mask) & (value)); \
+        (port) = GPIO_SHADOW(port);                                                     \
+        EA = gpioEa;                                                                    \
+    } while (0)
+#else
+#define GPIO_PORT_SET_CLEAR(port, set, clr)                                            \
+    do {                                                                                \
+        (port) &= (uint8_t)~(clr);                                                      \
+        (port) |= (uint8_t)(set);                                                       \
+    } while (0)
+#define GPIO_PORT_WRITE_MASKED(port, mask, value)                                      \
+    do {                                                                                \
+        (port) &= (uint8_t)~((mask) & ~(value));                                        \
+        (port) |= (uint8_t)((mask) & (value));                                          \
+    } while (0)
+#endif
+
 
 /*
  *@fn        -   gpioMode
@@ -63,6 +166,33 @@ void gpioPortWrite(uint8_t port, uint8_t value);
  */
 void gpioPinWrite(uint8_t port, uint8_t pinNum, uint8_t value);
 
+/*
+ *@fn        -   gpioPortWriteMasked
+ *
+ *@brief     -   Function to write the masked pins of a port, the other pins keep their state
+ *
+ *@param[1]  -   GPIO ports selection
+ *@param[2]  -   Pins to change
+ *@param[3]  -   New state of those pins
+ *
+ *return     -   void
+ */
+void gpioPortWriteMasked(uint8_t port, uint8_t mask, uint8_t value);
+
+/*
+ *@fn        -   gpioPortSetClear
+ *
+ *@brief     -   Function to set some pins and clear others of a port in one call,
+ *               a pin in both masks ends up set
+ *
+ *@param[1]  -   GPIO ports selection
+ *@param[2]  -   Pins to set
+ *@param[3]  -   Pins to clear
+ *
+ *return     -   void
+ */
+void gpioPortSetClear(uint8_t port, uint8_t set, uint8_t clr);
+
 /*
  *@fn        -   gpioPortToggle
  *
@@ -109,6 +239,43 @@ uint8_t gpioPortRead(uint8_t port);
  */
 uint8_t gpioPinRead(uint8_t port, uint8_t pinNum);
 
+#ifdef GPIO_USE_SHADOW
+/*
+ *@fn        -   gpioShadowPinWrite
+ *
+ *@brief     -   Function to change a pin in the port shadow only, the pin follows on commit
+ *
+ *@param[1]  -   GPIO ports selection
+ *@param[2]  -   Pin number of GPIO ports
+ *@param[3]  -   value to write
+ *
+ *return     -   void
+ */
+void gpioShadowPinWrite(uint8_t port, uint8_t pinNum, uint8_t value);
+
+/*
+ *@fn        -   gpioShadowCommit
+ *
+ *@brief     -   Function to store the port shadow to the port in one write
+ *
+ *@param[1]  -   GPIO ports selection
+ *
+ *return     -   void
+ */
+void gpioShadowCommit(uint8_t port);
+
+/*
+ *@fn        -   gpioShadowRead
+ *
+ *@brief     -   Function to read the intended output state of a port, not its pins
+ *
+ *@param[1]  -   GPIO ports selection
+ *
+ *return     -   uint8_t
+ */
+uint8_t gpioShadowRead(uint8_t port);
+#endif // GPIO_USE_SHADOW
+
 /*
  *@fn        -   gpioInterruptConfig
  *
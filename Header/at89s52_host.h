@@ -0,0 +1,313 @@
+#ifndef AT89S52_HOST_H
+#define AT89S52_HOST_H
+
+/*
+ * at89s52_host.h
+ * Description: Host backend for at89s52.h. When the drivers are built with gcc/clang and
+ *              -DAT89S52_HOST, every SFR and SFR bit maps to an emulated register file in
+ *              at89s52_host.c instead of the SDCC __sfr/__sbit declarations.
+ *              Each SFR access advances the emulation by one machine cycle, which runs
+ *              the timers, the UART model, the user hook and the interrupt dispatcher.
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+/* Standard library for proper data types */
+#include <stdint.h>
+
+/*------------------------------SDCC keywords on the host------------------------------------------------*/
+#define __data
+#define __idata
+#define __pdata
+#define __xdata
+#define __code
+#define __bit               uint8_t
+#define __interrupt(n)
+#define __using(n)
+#define __reentrant
+#define __naked
+
+/* RAM flags written by an ISR only change while the emulation runs, so RAM spin loops step it */
+#define IDLE_POLL()         hostStep(1)
+
+/*------------------------------Emulated register file---------------------------------------------------*/
+typedef union
+{
+    uint8_t byte;
+    struct
+    {
+        _Bool b0 : 1;
+        _Bool b1 : 1;
+        _Bool b2 : 1;
+        _Bool b3 : 1;
+        _Bool b4 : 1;
+        _Bool b5 : 1;
+        _Bool b6 : 1;
+        _Bool b7 : 1;
+    } bit;
+} hostSfr_t;
+
+/* _Bool bit-fields convert like an SDCC __bit store, any non-zero value sets the bit */
+
+/* Raw register file, index is (SFR address - 0x80). Hooks may read and write it freely */
+extern volatile hostSfr_t hostSfrFile[128];
+
+/* SBUF holds 0x100 | byte while idle, a write from the driver clears bit 8 and starts a transmit */
+#define HOST_SBUF_IDLE      0x100
+
+#define HOST_SFR(addr)      (hostSfrAccess(addr)->byte)
+#define HOST_SBIT(addr, n)  (hostSfrAccess(addr)->bit.b##n)
+
+/* BYTE addressable registers */
+#define P0      HOST_SFR(0x80)
+#define SP      HOST_SFR(0x81)
+#define DPL     HOST_SFR(0x82)
+#define DPH     HOST_SFR(0x83)
+#define PCON    HOST_SFR(0x87)
+#define TCON    HOST_SFR(0x88)
+#define TMOD    HOST_SFR(0x89)
+#define TL0     HOST_SFR(0x8A)
+#define TL1     HOST_SFR(0x8B)
+#define TH0     HOST_SFR(0x8C)
+#define TH1     HOST_SFR(0x8D)
+#define P1      HOST_SFR(0x90)
+#define SCON    HOST_SFR(0x98)
+#define SBUF    (*hostSbufAccess())
+#define P2      HOST_SFR(0xA0)
+#define IE      HOST_SFR(0xA8)
+#define P3      HOST_SFR(0xB0)
+#define IP      HOST_SFR(0xB8)
+#define T2CON   HOST_SFR(0xC8)
+#define T2MOD   HOST_SFR(0xC9)
+#define RCAP2L  HOST_SFR(0xCA)
+#define RCAP2H  HOST_SFR(0xCB)
+#define TL2     HOST_SFR(0xCC)
+#define TH2     HOST_SFR(0xCD)
+#define PSW     HOST_SFR(0xD0)
+#define ACC     HOST_SFR(0xE0)
+#define B       HOST_SFR(0xF0)
+
+/* BIT addressable registers, T0/T1/T2 pin bits are shadowed by the timer macros as on target */
+/* P0 */
+#define P0_0    HOST_SBIT(0x80, 0)
+#define P0_1    HOST_SBIT(0x80, 1)
+#define P0_2    HOST_SBIT(0x80, 2)
+#define P0_3    HOST_SBIT(0x80, 3)
+#define P0_4    HOST_SBIT(0x80, 4)
+#define P0_5    HOST_SBIT(0x80, 5)
+#define P0_6    HOST_SBIT(0x80, 6)
+#define P0_7    HOST_SBIT(0x80, 7)
+
+/* TCON */
+#define IT0     HOST_SBIT(0x88, 0)
+#define IE0     HOST_SBIT(0x88, 1)
+#define IT1     HOST_SBIT(0x88, 2)
+#define IE1     HOST_SBIT(0x88, 3)
+#define TR0     HOST_SBIT(0x88, 4)
+#define TF0     HOST_SBIT(0x88, 5)
+#define TR1     HOST_SBIT(0x88, 6)
+#define TF1     HOST_SBIT(0x88, 7)
+
+/* P1 */
+#define P1_0    HOST_SBIT(0x90, 0)
+#define P1_1    HOST_SBIT(0x90, 1)
+#define P1_2    HOST_SBIT(0x90, 2)
+#define P1_3    HOST_SBIT(0x90, 3)
+#define P1_4    HOST_SBIT(0x90, 4)
+#define P1_5    HOST_SBIT(0x90, 5)
+#define P1_6    HOST_SBIT(0x90, 6)
+#define P1_7    HOST_SBIT(0x90, 7)
+
+/* Timer 2 Control */
+#define T2EX    HOST_SBIT(0x90, 1)
+
+/* SCON */
+#define RI      HOST_SBIT(0x98, 0)
+#define TI      HOST_SBIT(0x98, 1)
+#define RB8     HOST_SBIT(0x98, 2)
+#define TB8     HOST_SBIT(0x98, 3)
+#define REN     HOST_SBIT(0x98, 4)
+#define SM2     HOST_SBIT(0x98, 5)
+#define SM1     HOST_SBIT(0x98, 6)
+#define SM0     HOST_SBIT(0x98, 7)
+
+/* P2 */
+#define P2_0    HOST_SBIT(0xA0, 0)
+#define P2_1    HOST_SBIT(0xA0, 1)
+#define P2_2    HOST_SBIT(0xA0, 2)
+#define P2_3    HOST_SBIT(0xA0, 3)
+#define P2_4    HOST_SBIT(0xA0, 4)
+#define P2_5    HOST_SBIT(0xA0, 5)
+#define P2_6    HOST_SBIT(0xA0, 6)
+#define P2_7    HOST_SBIT(0xA0, 7)
+
+/* IE */
+#define EX0     HOST_SBIT(0xA8, 0)
+#define ET0     HOST_SBIT(0xA8, 1)
+#define EX1     HOST_SBIT(0xA8, 2)
+#define ET1     HOST_SBIT(0xA8, 3)
+#define ES      HOST_SBIT(0xA8, 4)
+#define ET2     HOST_SBIT(0xA8, 5)
+#define EA      HOST_SBIT(0xA8, 7)
+
+/* P3 */
+#define P3_0    HOST_SBIT(0xB0, 0)
+#define P3_1    HOST_SBIT(0xB0, 1)
+#define P3_2    HOST_SBIT(0xB0, 2)
+#define P3_3    HOST_SBIT(0xB0, 3)
+#define P3_4    HOST_SBIT(0xB0, 4)
+#define P3_5    HOST_SBIT(0xB0, 5)
+#define P3_6    HOST_SBIT(0xB0, 6)
+#define P3_7    HOST_SBIT(0xB0, 7)
+
+#define RXD     HOST_SBIT(0xB0, 0)
+#define TXD     HOST_SBIT(0xB0, 1)
+#define INT0    HOST_SBIT(0xB0, 2)
+#define INT1    HOST_SBIT(0xB0, 3)
+#define WR      HOST_SBIT(0xB0, 6)
+#define RD      HOST_SBIT(0xB0, 7)
+
+/* IP */
+#define PX0     HOST_SBIT(0xB8, 0)
+#define PT0     HOST_SBIT(0xB8, 1)
+#define PX1     HOST_SBIT(0xB8, 2)
+#define PT1     HOST_SBIT(0xB8, 3)
+#define PS      HOST_SBIT(0xB8, 4)
+#define PT2     HOST_SBIT(0xB8, 5)
+
+/* T2CON */
+#define CP_RL2  HOST_SBIT(0xC8, 0)
+#define C_T2    HOST_SBIT(0xC8, 1)
+#define TR2     HOST_SBIT(0xC8, 2)
+#define EXEN2   HOST_SBIT(0xC8, 3)
+#define TCLK    HOST_SBIT(0xC8, 4)
+#define RCLK    HOST_SBIT(0xC8, 5)
+#define EXF2    HOST_SBIT(0xC8, 6)
+#define TF2     HOST_SBIT(0xC8, 7)
+
+/* PSW */
+#define P       HOST_SBIT(0xD0, 0)
+#define FL      HOST_SBIT(0xD0, 1)
+#define OV      HOST_SBIT(0xD0, 2)
+#define RS0     HOST_SBIT(0xD0, 3)
+#define RS1     HOST_SBIT(0xD0, 4)
+#define F0      HOST_SBIT(0xD0, 5)
+#define AC      HOST_SBIT(0xD0, 6)
+#define CY      HOST_SBIT(0xD0, 7)
+
+/*------------------------------Emulator control---------------------------------------------------------*/
+typedef void (*hostHook_t)(void);
+
+/*
+ *@fn        -   hostSfrAccess
+ *
+ *@brief     -   Function to advance the emulation one machine cycle and return the SFR cell
+ *
+ *@param[1]  -   SFR address, 0x80 to 0xFF
+ *
+ *return     -   volatile hostSfr_t *
+ */
+volatile hostSfr_t *hostSfrAccess(uint8_t addr);
+
+/*
+ *@fn        -   hostSbufAccess
+ *
+ *@brief     -   Function to advance the emulation one machine cycle and return the SBUF cell
+ *
+ *@param[1]  -   void
+ *
+ *return     -   volatile uint16_t *
+ */
+volatile uint16_t *hostSbufAccess(void);
+
+/*
+ *@fn        -   hostReset
+ *
+ *@brief     -   Function to load the reset values of every SFR and clear the emulator state
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+void hostReset(void);
+
+/*
+ *@fn        -   hostStep
+ *
+ *@brief     -   Function to advance the emulation by a number of machine cycles
+ *
+ *@param[1]  -   Number of machine cycles
+ *
+ *return     -   void
+ */
+void hostStep(uint32_t cycles);
+
+/*
+ *@fn        -   hostCycles
+ *
+ *@brief     -   Function to get the machine cycles elapsed since hostReset
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint32_t
+ */
+uint32_t hostCycles(void);
+
+/*
+ *@fn        -   hostSetHook
+ *
+ *@brief     -   Function to install a callback run on every emulated machine cycle
+ *
+ *@param[1]  -   Hook function, 0 to remove
+ *
+ *return     -   void
+ */
+void hostSetHook(hostHook_t hook);
+
+/*
+ *@fn        -   hostAttachIsr
+ *
+ *@brief     -   Function to register the handler the dispatcher calls for an interrupt vector
+ *
+ *@param[1]  -   Vector number, INT0_VECTOR to TIMER2_VECTOR
+ *@param[2]  -   ISR function, 0 to remove
+ *
+ *return     -   void
+ */
+void hostAttachIsr(uint8_t vector, hostHook_t isr);
+
+/*
+ *@fn        -   hostUartSetByteCycles
+ *
+ *@brief     -   Function to set how many machine cycles the fake UART takes per byte
+ *
+ *@param[1]  -   Machine cycles per byte
+ *
+ *return     -   void
+ */
+void hostUartSetByteCycles(uint32_t cycles);
+
+/*
+ *@fn        -   hostUartRxPush
+ *
+ *@brief     -   Function to queue a byte for the fake UART to receive, bit 8 goes to RB8
+ *
+ *@param[1]  -   Byte to receive
+ *
+ *return     -   uint8_t, 0 if the queue is full
+ */
+uint8_t hostUartRxPush(uint16_t data);
+
+/*
+ *@fn        -   hostUartTxPop
+ *
+ *@brief     -   Function to take the next byte the fake UART transmitted, bit 8 holds TB8
+ *
+ *@param[1]  -   void
+ *
+ *return     -   int, -1 if nothing was transmitted
+ */
+int hostUartTxPop(void);
+
+#endif // AT89S52_HOST_H
@@ -0,0 +1,98 @@
+#ifndef AT89S52_I2C_H
+#define AT89S52_I2C_H
+
+/*
+ * at89s52_i2c.h
+ * Description: This header file contains function declarations for at89s52_i2c.c file
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for the compile time pin macros, pulls in the SFR mnemonics
+#include "at89s52_gpio.h"
+
+/*
+ * Pins, __sbit names from at89s52.h. Port pins are quasi-bidirectional: a 1 releases the
+ * line to the pull-up and a 0 drives it low, which is the open drain an I2C bus needs.
+ * External pull-ups are still required.
+ */
+#ifndef I2C_SCL
+#define I2C_SCL P1_0
+#endif
+
+#ifndef I2C_SDA
+#define I2C_SDA P1_1
+#endif
+
+/* Bus speed in Hz, 100000 or 400000. It is an upper limit, the bit code itself takes
+ * about 4 machine cycles per half period, so at 12 MHz the bus runs near 100 kHz either way */
+#ifndef I2C_SPEED
+#define I2C_SPEED 100000UL
+#endif
+
+/* How long a slave may stretch the clock before the transfer fails with I2C_TIMEOUT */
+#ifndef I2C_TIMEOUT_US
+#define I2C_TIMEOUT_US 1000UL
+#endif
+
+/* Transfer results */
+#define I2C_OK          0
+#define I2C_NACK        1   // address or data byte not acknowledged
+#define I2C_TIMEOUT     2   // SCL held low longer than I2C_TIMEOUT_US
+
+/*
+ *@fn        -   i2cInit
+ *
+ *@brief     -   Function to release the bus, clocks out a slave left holding SDA low
+ *               by a reset in the middle of a read, then sends a stop
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+void i2cInit(void);
+
+/*
+ *@fn        -   i2cWrite
+ *
+ *@brief     -   Function to write a burst of bytes to a slave
+ *
+ *@param[1]  -   7 bit slave address
+ *@param[2]  -   Data reference
+ *@param[3]  -   Number of bytes
+ *
+ *return     -   uint8_t, I2C_OK, I2C_NACK or I2C_TIMEOUT
+ */
+uint8_t i2cWrite(uint8_t address, const uint8_t *buf, uint8_t len);
+
+/*
+ *@fn        -   i2cRead
+ *
+ *@brief     -   Function to read a burst of bytes from a slave, the last byte is not acknowledged
+ *
+ *@param[1]  -   7 bit slave address
+ *@param[2]  -   Buffer reference
+ *@param[3]  -   Number of bytes, at least 1
+ *
+ *return     -   uint8_t, I2C_OK, I2C_NACK or I2C_TIMEOUT
+ */
+uint8_t i2cRead(uint8_t address, uint8_t *buf, uint8_t len);
+
+/*
+ *@fn        -   i2cWriteRead
+ *
+ *@brief     -   Function to write then read in one transaction with a repeated start,
+ *               e.g. a register number then its contents
+ *
+ *@param[1]  -   7 bit slave address
+ *@param[2]  -   Data to write
+ *@param[3]  -   Number of bytes to write
+ *@param[4]  -   Buffer for the read
+ *@param[5]  -   Number of bytes to read, at least 1
+ *
+ *return     -   uint8_t, I2C_OK, I2C_NACK or I2C_TIMEOUT
+ */
+uint8_t i2cWriteRead(uint8_t address, const uint8_t *tx, uint8_t txLen, uint8_t *rx, uint8_t rxLen);
+
+#endif // AT89S52_I2C_H
@@ -0,0 +1,127 @@
+#ifndef AT89S52_KEYPAD_H
+#define AT89S52_KEYPAD_H
+
+/*
+ * at89s52_keypad.h
+ * Description: This header file contains function declarations for at89s52_keypad.c file
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for the tick the scan runs on
+#include "at89s52_tick.h"
+
+/*
+ * Matrix wiring. Rows are driven low one at a time, columns are read with the internal
+ * pull-ups. Rows sit at KEYPAD_ROW_SHIFT on KEYPAD_ROW_PORT and columns at KEYPAD_COL_SHIFT
+ * on KEYPAD_COL_PORT, both ports may be the same, e.g. a 4x4 pad on P1 with shifts 0 and 4.
+ */
+#ifndef KEYPAD_ROW_PORT
+#define KEYPAD_ROW_PORT P2
+#endif
+
+#ifndef KEYPAD_COL_PORT
+#define KEYPAD_COL_PORT P1
+#endif
+
+#ifndef KEYPAD_ROWS
+#define KEYPAD_ROWS 4
+#endif
+
+#ifndef KEYPAD_COLS
+#define KEYPAD_COLS 4
+#endif
+
+#ifndef KEYPAD_ROW_SHIFT
+#define KEYPAD_ROW_SHIFT 0
+#endif
+
+#ifndef KEYPAD_COL_SHIFT
+#define KEYPAD_COL_SHIFT 0
+#endif
+
+/* Key events the FIFO holds, must be a power of two and not more than 128 */
+#ifndef KEYPAD_FIFO_SIZE
+#define KEYPAD_FIFO_SIZE 8
+#endif
+
+/* Define when every key has a series diode, the matrix cannot ghost and the check is skipped */
+// #define KEYPAD_DIODES
+
+/* Event byte: bit 7 set on release, bits 5-3 row, bits 2-0 column */
+#define KEYPAD_RELEASED     0x80
+#define KEYPAD_ROW(event)   (((event) >> 3) & 0x07)
+#define KEYPAD_COL(event)   ((event) & 0x07)
+
+/*
+ *@fn        -   keypadInit
+ *
+ *@brief     -   Function to set up the matrix pins and attach the scan to the tick. One row
+ *               is read per tick, a full scan takes KEYPAD_ROWS ticks, a key change is taken
+ *               when two scans agree
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t, 0 if the tick has no free hook
+ */
+uint8_t keypadInit(void);
+
+/*
+ *@fn        -   keypadRead
+ *
+ *@brief     -   Function to take the oldest key event, never blocks
+ *
+ *@param[1]  -   Reference to store the event byte
+ *
+ *return     -   uint8_t, 1 if an event was read else 0
+ */
+uint8_t keypadRead(uint8_t *event);
+
+/*
+ *@fn        -   keypadAvailable
+ *
+ *@brief     -   Function to get the number of key events waiting
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t
+ */
+uint8_t keypadAvailable(void);
+
+/*
+ *@fn        -   keypadRow
+ *
+ *@brief     -   Function to get the keys held in a row, any number of keys may be held
+ *
+ *@param[1]  -   Row number
+ *
+ *return     -   uint8_t, column mask
+ */
+uint8_t keypadRow(uint8_t row);
+
+/*
+ *@fn        -   keypadGhosted
+ *
+ *@brief     -   Function to check whether the last scan was ambiguous. Without diodes three
+ *               keys on the corners of a rectangle make the fourth read as pressed, such
+ *               scans are ignored and the held keys keep their last good state
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t
+ */
+uint8_t keypadGhosted(void);
+
+/*
+ *@fn        -   keypadOverflows
+ *
+ *@brief     -   Function to get the number of key events lost because the FIFO was full
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t
+ */
+uint8_t keypadOverflows(void);
+
+#endif // AT89S52_KEYPAD_H
@@ -0,0 +1,154 @@
+#ifndef AT89S52_LCD_H
+#define AT89S52_LCD_H
+
+/*
+ * at89s52_lcd.h
+ * Description: This header file contains function declarations for at89s52_lcd.c file
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for the port writes the bus goes through
+#include "at89s52_gpio.h"
+
+/* Display size, up to 4 rows of 20 */
+#ifndef LCD_COLS
+#define LCD_COLS 16
+#endif
+
+#ifndef LCD_ROWS
+#define LCD_ROWS 2
+#endif
+
+/* Port number of the data bus, PORT0 needs the usual pull-up network */
+#ifndef LCD_DATA_PORT
+#define LCD_DATA_PORT PORT0
+#endif
+
+/*
+ * Define LCD_4BIT to wire only D4-D7, on bits LCD_NIBBLE_SHIFT to LCD_NIBBLE_SHIFT + 3 of
+ * LCD_DATA_PORT. The other half of the port stays free.
+ */
+#ifndef LCD_NIBBLE_SHIFT
+#define LCD_NIBBLE_SHIFT 4
+#endif
+
+/* Control pins, __sbit names from at89s52.h */
+#ifndef LCD_RS
+#define LCD_RS P2_6
+#endif
+
+#ifndef LCD_EN
+#define LCD_EN P2_7
+#endif
+
+/*
+ * R/W is driven low for writes and raised to poll the busy flag. Define LCD_NO_RW when it is
+ * tied to ground, lcdRefresh() then sends one item per tick and needs tickInit().
+ */
+#ifndef LCD_RW
+#define LCD_RW P2_5
+#endif
+
+/* Memory space of the framebuffer, __data, __idata or __xdata */
+#ifndef LCD_BUFFER_SPACE
+#define LCD_BUFFER_SPACE __idata
+#endif
+
+#define LCD_CELLS (LCD_ROWS * LCD_COLS)
+
+/*
+ *@fn        -   lcdInit
+ *
+ *@brief     -   Function to reset and set up the controller, blocks for about 50 ms on delay_ms()
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+void lcdInit(void);
+
+/*
+ *@fn        -   lcdSetCursor
+ *
+ *@brief     -   Function to move the drawing position in the framebuffer
+ *
+ *@param[1]  -   Column, 0 to LCD_COLS - 1
+ *@param[2]  -   Row, 0 to LCD_ROWS - 1
+ *
+ *return     -   void
+ */
+void lcdSetCursor(uint8_t col, uint8_t row);
+
+/*
+ *@fn        -   lcdPutc
+ *
+ *@brief     -   Function to draw one character at the drawing position and advance it, the
+ *               cell is only marked for refresh when it changes. Wraps to the next row
+ *
+ *@param[1]  -   Character
+ *
+ *return     -   void
+ */
+void lcdPutc(uint8_t c);
+
+/*
+ *@fn        -   lcdPuts
+ *
+ *@brief     -   Function to draw a string at the drawing position
+ *
+ *@param[1]  -   String reference
+ *
+ *return     -   void
+ */
+void lcdPuts(const char *s);
+
+/*
+ *@fn        -   lcdPrint
+ *
+ *@brief     -   Function to draw formatted text at the drawing position, same formats as serialPrint
+ *
+ *@param[1]  -   Format string
+ *@param[2]  -   Arguments
+ *
+ *return     -   void
+ */
+void lcdPrint(const char *fmt, ...);
+
+/*
+ *@fn        -   lcdClear
+ *
+ *@brief     -   Function to blank the framebuffer and move the drawing position home
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+void lcdClear(void);
+
+/*
+ *@fn        -   lcdRefresh
+ *
+ *@brief     -   Function to send at most one changed character or address command to the
+ *               display, call it from the main loop. Returns at once when the controller is
+ *               busy or nothing changed
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+void lcdRefresh(void);
+
+/*
+ *@fn        -   lcdPending
+ *
+ *@brief     -   Function to get the number of cells still waiting for lcdRefresh()
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t
+ */
+uint8_t lcdPending(void);
+
+#endif // AT89S52_LCD_H
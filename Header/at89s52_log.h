@@ -0,0 +1,75 @@
+#ifndef AT89S52_LOG_H
+#define AT89S52_LOG_H
+
+/*
+ * at89s52_log.h
+ * Description: This header file contains function declarations for at89s52_log.c file
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for AT89S52 MCU, contains mnemounics for SFR's
+#include "at89s52.h"
+
+/* Format table shared with the host decoder in Tools/logdecode.c */
+#ifndef LOG_FORMAT_TABLE
+#define LOG_FORMAT_TABLE "at89s52_log_formats.h"
+#endif
+
+/* First byte of every record */
+#define LOG_SYNC 0xA5
+
+/* Largest argument block of one record */
+#define LOG_MAX_ARGS 16
+
+/*
+ * Record on the wire, little endian:
+ *   LOG_SYNC | id | argument length | millis() bits 0-15 | argument bytes
+ */
+#define LOG_HEADER_SIZE 5
+
+/* Ids LOG_<name> in table order */
+enum
+{
+#define LOG_FORMAT(name, fmt) LOG_##name,
+#include LOG_FORMAT_TABLE
+#undef LOG_FORMAT
+    LOG_FORMAT_COUNT
+};
+
+/* Call site helpers, every argument is sent as 16 bits, LOGL as 32 bits, LOGL1_1 a 32 then a 16 bit one */
+#define LOG0(id)                logRecord((id), 0, 0)
+#define LOG1(id, a)             do { int16_t logArgs_[1]; logArgs_[0] = (a); logRecord((id), logArgs_, sizeof(logArgs_)); } while (0)
+#define LOG2(id, a, b)          do { int16_t logArgs_[2]; logArgs_[0] = (a); logArgs_[1] = (b); logRecord((id), logArgs_, sizeof(logArgs_)); } while (0)
+#define LOG3(id, a, b, c)       do { int16_t logArgs_[3]; logArgs_[0] = (a); logArgs_[1] = (b); logArgs_[2] = (c); logRecord((id), logArgs_, sizeof(logArgs_)); } while (0)
+#define LOGL1(id, a)            do { int32_t logArgs_[1]; logArgs_[0] = (a); logRecord((id), logArgs_, sizeof(logArgs_)); } while (0)
+#define LOGL1_1(id, a, b)       do { int16_t logArgs_[3]; int32_t logLong_ = (a); logArgs_[0] = (int16_t)logLong_; logArgs_[1] = (int16_t)(logLong_ >> 16); logArgs_[2] = (b); logRecord((id), logArgs_, sizeof(logArgs_)); } while (0)
+
+/*
+ *@fn        -   logRecord
+ *
+ *@brief     -   Function to queue one binary log record for the UART. With SERIAL_USE_INTERRUPT
+ *               the record goes to the TX ring buffer whole or is dropped, it never blocks.
+ *               Call it from the main loop only, records from an ISR could interleave
+ *
+ *@param[1]  -   Format id LOG_<name>
+ *@param[2]  -   Raw argument bytes, laid out as the format expects
+ *@param[3]  -   Number of argument bytes, at most LOG_MAX_ARGS
+ *
+ *return     -   void
+ */
+void logRecord(uint8_t id, const void *args, uint8_t len);
+
+/*
+ *@fn        -   logDropped
+ *
+ *@brief     -   Function to get the number of records dropped because the TX buffer was full
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint16_t
+ */
+uint16_t logDropped(void);
+
+#endif // AT89S52_LOG_H
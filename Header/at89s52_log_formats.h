@@ -0,0 +1,20 @@
+/*
+ * at89s52_log_formats.h
+ * Description: Format table for the deferred binary log. Each LOG_FORMAT(name, "format") line
+ *              becomes the id LOG_<name> on the target and the text the host decoder prints.
+ *              Arguments are 2 bytes each, 4 bytes with the l modifier, the comment names the
+ *              LOG macro that packs them. Keep entries in the same order in firmware and
+ *              decoder builds, add new ones at the end.
+ *              Point LOG_FORMAT_TABLE at a copy of this file to use an application table.
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+/* No include guard, this file is included once per expansion of LOG_FORMAT */
+
+LOG_FORMAT(BOOT,        "boot")                         // LOG0
+LOG_FORMAT(BAUD,        "uart %lu baud, error %.2k%%")  // LOGL1_1
+LOG_FORMAT(VALUE,       "value %d")                     // LOG1
+LOG_FORMAT(VALUE2,      "values %d %d")                 // LOG2
+LOG_FORMAT(REGISTER,    "register 0x%02x = 0x%02x")     // LOG2
@@ -0,0 +1,145 @@
+#ifndef AT89S52_ONEWIRE_H
+#define AT89S52_ONEWIRE_H
+
+/*
+ * at89s52_onewire.h
+ * Description: This header file contains function declarations for at89s52_onewire.c file
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for the compile time pin macros, pulls in the SFR mnemonics
+#include "at89s52_gpio.h"
+
+/* Bus pin, an __sbit name from at89s52.h. Needs the usual 4.7k pull-up */
+#ifndef ONEWIRE_PIN
+#define ONEWIRE_PIN P3_7
+#endif
+
+/*
+ * Slot timing calibration, in machine cycles. The pin write and the DJNZ load around each
+ * timed wait are taken out of the loop count, retune in s51 like the delay_us() constants.
+ */
+#ifndef ONEWIRE_OVERHEAD
+#define ONEWIRE_OVERHEAD 3
+#endif
+
+/* Results */
+#define ONEWIRE_OK          0
+#define ONEWIRE_NO_DEVICE   1   // no presence pulse, or the search has no more devices
+#define ONEWIRE_CRC_ERROR   2
+
+/* ROM commands */
+#define ONEWIRE_SEARCH_ROM  0xF0
+#define ONEWIRE_READ_ROM    0x33
+#define ONEWIRE_MATCH_ROM   0x55
+#define ONEWIRE_SKIP_ROM    0xCC
+
+/* Bytes in a ROM code, family code first and CRC-8 last */
+#define ONEWIRE_ROM_SIZE    8
+
+/*
+ *@fn        -   onewireReset
+ *
+ *@brief     -   Function to send a reset pulse and check for a presence pulse
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t, ONEWIRE_OK or ONEWIRE_NO_DEVICE
+ */
+uint8_t onewireReset(void);
+
+/*
+ *@fn        -   onewireWriteBit
+ *
+ *@brief     -   Function to send one write slot, interrupts are masked only while the line is low
+ *
+ *@param[1]  -   Bit value
+ *
+ *return     -   void
+ */
+void onewireWriteBit(uint8_t value);
+
+/*
+ *@fn        -   onewireReadBit
+ *
+ *@brief     -   Function to send one read slot, interrupts are masked from the start of the
+ *               slot to the sample point
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t, bit value
+ */
+uint8_t onewireReadBit(void);
+
+/*
+ *@fn        -   onewireWriteByte
+ *
+ *@brief     -   Function to send a byte LSB first
+ *
+ *@param[1]  -   Byte to send
+ *
+ *return     -   void
+ */
+void onewireWriteByte(uint8_t b);
+
+/*
+ *@fn        -   onewireReadByte
+ *
+ *@brief     -   Function to read a byte LSB first
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t
+ */
+uint8_t onewireReadByte(void);
+
+/*
+ *@fn        -   onewireSelect
+ *
+ *@brief     -   Function to reset the bus and address one device, or all of them
+ *
+ *@param[1]  -   ROM code of the device, 0 to skip ROM and address every device
+ *
+ *return     -   uint8_t, ONEWIRE_OK or ONEWIRE_NO_DEVICE
+ */
+uint8_t onewireSelect(const uint8_t *rom);
+
+/*
+ *@fn        -   onewireSearchBegin
+ *
+ *@brief     -   Function to restart the ROM search from the first device
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+void onewireSearchBegin(void);
+
+/*
+ *@fn        -   onewireSearch
+ *
+ *@brief     -   Function to find the next device on the bus. The buffer also holds the
+ *               search position, pass the same one back unchanged on each call
+ *
+ *@param[1]  -   ROM code buffer, ONEWIRE_ROM_SIZE bytes
+ *
+ *return     -   uint8_t, ONEWIRE_OK, ONEWIRE_NO_DEVICE when done or ONEWIRE_CRC_ERROR
+ */
+uint8_t onewireSearch(uint8_t *rom);
+
+/*
+ *@fn        -   onewireCrc8
+ *
+ *@brief     -   Function to update the Dallas/Maxim CRC-8, a buffer ending in its CRC gives 0
+ *
+ *@param[1]  -   CRC so far, 0 to start
+ *@param[2]  -   Data reference
+ *@param[3]  -   Number of bytes
+ *
+ *return     -   uint8_t
+ */
+uint8_t onewireCrc8(uint8_t crc, const uint8_t *buf, uint8_t len);
+
+#endif // AT89S52_ONEWIRE_H
@@ -0,0 +1,119 @@
+#ifndef AT89S52_PACKET_H
+#define AT89S52_PACKET_H
+
+/*
+ * at89s52_packet.h
+ * Description: This header file contains function declarations for at89s52_packet.c file
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for AT89S52 MCU, contains mnemounics for SFR's
+#include "at89s52.h"
+
+/*
+ * Frame on the wire: COBS(payload | CRC-16 high | CRC-16 low) 0x00
+ * CRC-16/CCITT-FALSE, polynomial 0x1021, initial value 0xFFFF. COBS removes every zero from
+ * the frame so 0x00 only ever marks its end, a receiver joining mid stream resyncs there.
+ */
+#define PACKET_CRC_INIT     0xFFFF
+
+/* Largest payload, the decoded frame including the CRC must fit in 255 bytes */
+#define PACKET_MAX_PAYLOAD  253
+
+/* Receive buffer bytes needed for a payload of len bytes, the CRC is decoded into it too */
+#define PACKET_RX_SIZE(len) ((len) + 2)
+
+/* packetRxByte() results */
+#define PACKET_PENDING      0   // frame still arriving, or decoder not armed
+#define PACKET_DONE         1   // a good frame is in the buffer, see packetRxLength()
+#define PACKET_ERROR        2   // bad CRC, overflow or truncated frame, decoder rearmed
+
+/*
+ *@fn        -   packetCrc
+ *
+ *@brief     -   Function to run the CRC-16 over a block, nibble table in code memory
+ *
+ *@param[1]  -   Running CRC, PACKET_CRC_INIT for a new block
+ *@param[2]  -   Data reference
+ *@param[3]  -   Number of bytes
+ *
+ *return     -   uint16_t
+ */
+uint16_t packetCrc(uint16_t crc, const uint8_t *buf, uint8_t len);
+
+/*
+ *@fn        -   packetSend
+ *
+ *@brief     -   Function to send one frame with serialTx, encoded on the fly without a copy
+ *
+ *@param[1]  -   Payload reference
+ *@param[2]  -   Payload length, at most PACKET_MAX_PAYLOAD
+ *
+ *return     -   void
+ */
+void packetSend(const uint8_t *payload, uint8_t len);
+
+/*
+ *@fn        -   packetRxBegin
+ *
+ *@brief     -   Function to arm the decoder with the buffer the next frame is decoded into.
+ *               When bytes of a frame already went by unarmed, the decoder waits for the
+ *               next delimiter first, so it never returns the tail of a frame
+ *
+ *@param[1]  -   Buffer reference
+ *@param[2]  -   Buffer size, PACKET_RX_SIZE(largest payload)
+ *
+ *return     -   void
+ */
+void packetRxBegin(uint8_t *buffer, uint8_t size);
+
+/*
+ *@fn        -   packetRxByte
+ *
+ *@brief     -   Function to feed one received byte to the decoder. Runs straight from the
+ *               UART ISR with -DSERIAL_RX_HOOK=packetRxByte, or from the main loop with
+ *               bytes from serialTryRead, not both. After PACKET_DONE bytes are ignored
+ *               until packetRxBegin rearms the decoder
+ *
+ *@param[1]  -   Received byte
+ *
+ *return     -   uint8_t, PACKET_PENDING, PACKET_DONE or PACKET_ERROR
+ */
+uint8_t packetRxByte(uint8_t c);
+
+/*
+ *@fn        -   packetRxReady
+ *
+ *@brief     -   Function to check whether a good frame is waiting in the buffer
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t
+ */
+uint8_t packetRxReady(void);
+
+/*
+ *@fn        -   packetRxLength
+ *
+ *@brief     -   Function to get the payload length of the frame in the buffer
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t
+ */
+uint8_t packetRxLength(void);
+
+/*
+ *@fn        -   packetRxErrors
+ *
+ *@brief     -   Function to get the number of frames dropped for CRC, overflow or framing
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint16_t
+ */
+uint16_t packetRxErrors(void);
+
+#endif // AT89S52_PACKET_H
@@ -0,0 +1,113 @@
+#ifndef AT89S52_PWM_H
+#define AT89S52_PWM_H
+
+/*
+ * at89s52_pwm.h
+ * Description: This header file contains function declarations for at89s52_pwm.c file
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for the Timer 0 setup and timer0Busy
+#include "at89s52_timer.h"
+
+/*
+ * Port the channels drive, channel n is bit n. The ISR writes it with ANL/ORL, so other pins
+ * on the port stay usable as long as the main loop also changes them in one instruction
+ * (GPIO_PIN_SET/CLEAR) and not with a read, modify and separate write.
+ */
+#ifndef PWM_PORT
+#define PWM_PORT P2
+#endif
+
+/* Number of channels, 1 to 8 */
+#ifndef PWM_CHANNELS
+#define PWM_CHANNELS 8
+#endif
+
+/* Duty cycle steps, a duty of PWM_STEPS keeps the channel on for the whole period */
+#ifndef PWM_STEPS
+#define PWM_STEPS 255
+#endif
+
+/* Target PWM frequency in Hz, the period is rounded down to a whole number of steps */
+#ifndef PWM_FREQ
+#define PWM_FREQ 200
+#endif
+
+/*
+ * Machine cycles the ISR needs between two edges. Closer edges are merged into one interrupt
+ * and edges near the period start or end are pulled in, which moves a duty by less than this.
+ */
+#ifndef PWM_MIN_GAP
+#define PWM_MIN_GAP 48
+#endif
+
+/* Memory space of the two schedules, __data or __idata */
+#ifndef PWM_SCHEDULE_SPACE
+#define PWM_SCHEDULE_SPACE __idata
+#endif
+
+/* Timer counts per duty step and per period */
+#define PWM_STEP_COUNTS     ((uint16_t)((CLOCK_SOURCE / 12UL) / ((uint32_t)PWM_FREQ * PWM_STEPS)))
+#define PWM_PERIOD_COUNTS   ((uint16_t)(PWM_STEP_COUNTS * PWM_STEPS))
+
+/*
+ *@fn        -   pwmInit
+ *
+ *@brief     -   Function to start the PWM on Timer 0 with every channel off. Timer 0 stays
+ *               busy until pwmStop(), delay_us() waits on the tick meanwhile
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+void pwmInit(void);
+
+/*
+ *@fn        -   pwmStop
+ *
+ *@brief     -   Function to stop the PWM and drive every channel low
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+void pwmStop(void);
+
+/*
+ *@fn        -   pwmWrite
+ *
+ *@brief     -   Function to set the duty of one channel, it takes effect at the next period start
+ *
+ *@param[1]  -   Channel, 0 to PWM_CHANNELS - 1
+ *@param[2]  -   Duty, 0 to PWM_STEPS
+ *
+ *return     -   void
+ */
+void pwmWrite(uint8_t channel, uint8_t duty);
+
+/*
+ *@fn        -   pwmWriteAll
+ *
+ *@brief     -   Function to set the duty of every channel, all of them change in the same period
+ *
+ *@param[1]  -   PWM_CHANNELS duties, 0 to PWM_STEPS
+ *
+ *return     -   void
+ */
+void pwmWriteAll(const uint8_t *duty);
+
+/*
+ *@fn        -   pwmIsr
+ *
+ *@brief     -   Timer 0 interrupt service routine, runs once per distinct edge
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+void pwmIsr(void) __interrupt(TIMER0_VECTOR);
+
+#endif // AT89S52_PWM_H
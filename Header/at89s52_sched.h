@@ -0,0 +1,110 @@
+#ifndef AT89S52_SCHED_H
+#define AT89S52_SCHED_H
+
+/*
+ * at89s52_sched.h
+ * Description: This header file contains function declarations for at89s52_sched.c file
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for the tick that releases the tasks
+#include "at89s52_tick.h"
+
+/* One task per priority level, 0 is the lowest and 7 the highest */
+#define SCHED_MAX_TASKS 8
+
+/* Length of the window the idle percentage is measured over, in microseconds */
+#ifndef SCHED_WINDOW_US
+#define SCHED_WINDOW_US 1000000UL
+#endif
+
+/* Run by schedRun() whenever no task is ready */
+#ifndef SCHED_IDLE
+#define SCHED_IDLE() IDLE_POLL()
+#endif
+
+/* Task body, runs to completion from the main loop */
+typedef void (*schedTask_t)(void);
+
+/*
+ *@fn        -   schedInit
+ *
+ *@brief     -   Function to clear the task table and attach the scheduler to the tick
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t, 0 if the tick has no free hook
+ */
+uint8_t schedInit(void);
+
+/*
+ *@fn        -   schedAdd
+ *
+ *@brief     -   Function to register a periodic task
+ *
+ *@param[1]  -   Priority 0 to 7, each level holds one task
+ *@param[2]  -   Period in ticks, at least 1
+ *@param[3]  -   Task function
+ *
+ *return     -   uint8_t, 0 if the priority is taken or a parameter is invalid
+ */
+uint8_t schedAdd(uint8_t priority, uint16_t period, schedTask_t task);
+
+/*
+ *@fn        -   schedRemove
+ *
+ *@brief     -   Function to unregister the task at a priority level
+ *
+ *@param[1]  -   Priority 0 to 7
+ *
+ *return     -   void
+ */
+void schedRemove(uint8_t priority);
+
+/*
+ *@fn        -   schedDispatch
+ *
+ *@brief     -   Function to run the highest priority ready task once
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t, 0 if no task was ready
+ */
+uint8_t schedDispatch(void);
+
+/*
+ *@fn        -   schedRun
+ *
+ *@brief     -   Function to dispatch tasks forever, calls SCHED_IDLE() when none is ready
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+void schedRun(void);
+
+/*
+ *@fn        -   schedWcet
+ *
+ *@brief     -   Function to get the longest measured run time of a task
+ *
+ *@param[1]  -   Priority 0 to 7
+ *
+ *return     -   uint16_t, microseconds, saturates at 65535
+ */
+uint16_t schedWcet(uint8_t priority);
+
+/*
+ *@fn        -   schedIdlePercent
+ *
+ *@brief     -   Function to get the share of the last window spent outside tasks
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t, 0 to 100
+ */
+uint8_t schedIdlePercent(void);
+
+#endif // AT89S52_SCHED_H
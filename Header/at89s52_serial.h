@@ -15,10 +15,50 @@
 // Library for AT89S52 MCU, contains mnemounics for SFR's  
 #include "at89s52.h"
 
+/*
+ * Build with -DSERIAL_USE_INTERRUPT to run the UART from SERIAL_VECTOR with TX/RX ring
+ * buffers. Without it the driver stays in polled mode and serialTx()/serialRx() spin on TI/RI.
+ */
+#ifdef SERIAL_USE_INTERRUPT
+
+/* Ring buffer sizes, must be a power of two and not more than 128 */
+#ifndef SERIAL_TX_BUFFER_SIZE
+#define SERIAL_TX_BUFFER_SIZE 16
+#endif
+
+#ifndef SERIAL_RX_BUFFER_SIZE
+#define SERIAL_RX_BUFFER_SIZE 16
+#endif
+
+/* Memory space of the ring buffers, __idata or __xdata */
+#ifndef SERIAL_BUFFER_SPACE
+#define SERIAL_BUFFER_SPACE __idata
+#endif
+
+/*
+ * Optional consumer of every received byte, run in the ISR instead of the RX ring buffer,
+ * e.g. -DSERIAL_RX_HOOK=packetRxByte. Its return value is ignored.
+ */
+#ifdef SERIAL_RX_HOOK
+uint8_t SERIAL_RX_HOOK(uint8_t c);
+#endif
+
+#endif // SERIAL_USE_INTERRUPT
+
+/*
+ * Compile time reloads for serialInitTimer(), e.g. serialInitTimer(T2, SERIAL_T2_RELOAD(9600), 0).
+ * Timer 2:           baud = CLOCK_SOURCE / (32 * (65536 - RCAP2))
+ * Timer 1 in mode 2: baud = CLOCK_SOURCE / ((SMOD ? 192 : 384) * (256 - TH1))
+ */
+#define SERIAL_T2_RELOAD(baud)          ((uint16_t)(65536UL - (CLOCK_SOURCE / 32UL + (baud) / 2) / (baud)))
+#define SERIAL_T1_RELOAD(baud, smod)    ((uint16_t)(256UL - (CLOCK_SOURCE / ((smod) ? 192UL : 384UL) + (baud) / 2) / (baud)))
+
 /*
  *@fn        -   serialInit
  *
- *@brief     -   Function to configure the UART
+ *@brief     -   Function to configure the UART, picks the baud rate generator with the
+ *               smallest error: Timer 2 when the tick does not own it (TICK_TIMER != T2),
+ *               else Timer 1 with or without SMOD doubling
  *
  *@param[1]  -   Parameter will takes the baud rate value
  *
@@ -26,6 +66,71 @@
  */
 void serialInit(uint32_t baud);
 
+/*
+ *@fn        -   serialInitTimer
+ *
+ *@brief     -   Function to configure the UART with a known generator and reload,
+ *               use SERIAL_T1_RELOAD/SERIAL_T2_RELOAD to get it at compile time
+ *
+ *@param[1]  -   T1 or T2
+ *@param[2]  -   TH1 value for Timer 1, RCAP2 value for Timer 2
+ *@param[3]  -   SMOD bit for Timer 1, ignored for Timer 2
+ *
+ *return     -   void
+ */
+void serialInitTimer(uint8_t Tx, uint16_t reload, uint8_t smod);
+
+/* Multiprocessor (mode 3) destination every node accepts. A node set to it hears all traffic */
+#define SERIAL_MP_BROADCAST 0xFF
+
+/*
+ *@fn        -   serialMultiprocessorInit
+ *
+ *@brief     -   Function to switch the UART to 9 bit mode 3 as a bus node, call after serialInit.
+ *               With SM2 set only address bytes (ninth bit 1) interrupt, data bytes reach the
+ *               CPU only after the node address or SERIAL_MP_BROADCAST was received.
+ *               Address bytes are consumed by the driver, only data bytes are returned
+ *
+ *@param[1]  -   Node address, SERIAL_MP_BROADCAST for a master that hears every byte
+ *
+ *return     -   void
+ */
+void serialMultiprocessorInit(uint8_t address);
+
+/*
+ *@fn        -   serialTxAddress
+ *
+ *@brief     -   Function to send an address byte with the ninth bit (TB8) set, the data bytes
+ *               that follow with serialTx go to that node
+ *
+ *@param[1]  -   Destination node address or SERIAL_MP_BROADCAST
+ *
+ *return     -   void
+ */
+void serialTxAddress(uint8_t address);
+
+/*
+ *@fn        -   serialBaudActual
+ *
+ *@brief     -   Function to get the baud rate the configured generator really produces
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint32_t
+ */
+uint32_t serialBaudActual(void);
+
+/*
+ *@fn        -   serialBaudError
+ *
+ *@brief     -   Function to get the error of the configured baud rate against a requested one
+ *
+ *@param[1]  -   Requested baud rate
+ *
+ *return     -   int16_t, in 0.01% units, positive when the UART runs fast
+ */
+int16_t serialBaudError(uint32_t baud);
+
 /*
  *@fn        -   serialTx
  *
@@ -51,7 +156,7 @@ uint8_t serialRx(void);
 /*
  *@fn        -   serialPrint
  *
- *@brief     -   Function to transmitt the data string
+ *@brief     -   Function to transmitt the formatted data string, conversions as in formatPrint
  *
  *@param[1]  -   Buffer reference for transmitting
  *@param[2]  -   For multiple parameters
@@ -83,4 +188,50 @@ void serialWrite(uint8_t *buffer);
  */
 void serialRead(uint8_t *buffer, uint16_t maxLen);
 
+/*
+ *@fn        -   serialTxAvailable
+ *
+ *@brief     -   Function to get the number of bytes serialTx can take without blocking
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t
+ */
+uint8_t serialTxAvailable(void);
+
+/*
+ *@fn        -   serialRxAvailable
+ *
+ *@brief     -   Function to get the number of received bytes waiting to be read
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t
+ */
+uint8_t serialRxAvailable(void);
+
+/*
+ *@fn        -   serialTryRead
+ *
+ *@brief     -   Function to read 1byte data if one is available, never blocks
+ *
+ *@param[1]  -   Reference to store the received byte
+ *
+ *return     -   uint8_t, 1 if a byte was read else 0
+ */
+uint8_t serialTryRead(uint8_t *buf);
+
+#ifdef SERIAL_USE_INTERRUPT
+/*
+ *@fn        -   serialIsr
+ *
+ *@brief     -   UART interrupt service routine, moves bytes between SBUF and the ring buffers
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+void serialIsr(void) __interrupt(SERIAL_VECTOR);
+#endif
+
 #endif // at89s52_serial.h
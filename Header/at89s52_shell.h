@@ -0,0 +1,98 @@
+#ifndef AT89S52_SHELL_H
+#define AT89S52_SHELL_H
+
+/*
+ * at89s52_shell.h
+ * Description: This header file contains function declarations for at89s52_shell.c file
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for AT89S52 MCU, contains mnemounics for SFR's
+#include "at89s52.h"
+
+/* Bytes kept per line, the command name or the string arguments with their terminators */
+#ifndef SHELL_LINE_SIZE
+#define SHELL_LINE_SIZE 32
+#endif
+
+/* Most arguments one command takes */
+#ifndef SHELL_MAX_ARGS
+#define SHELL_MAX_ARGS 4
+#endif
+
+/* Memory space of the line buffer, __data, __idata or __xdata */
+#ifndef SHELL_BUFFER_SPACE
+#define SHELL_BUFFER_SPACE __idata
+#endif
+
+/* shellInput() and shellPoll() results */
+#define SHELL_PENDING   0   // line not complete yet
+#define SHELL_OK        1   // command ran
+#define SHELL_EMPTY     2   // blank line
+#define SHELL_UNKNOWN   3   // no such command
+#define SHELL_BAD_ARGS  4   // wrong number of arguments or a bad number
+#define SHELL_TOO_LONG  5   // name or string arguments did not fit SHELL_LINE_SIZE
+
+/* One parsed argument, the member follows the schema letter */
+typedef union
+{
+    uint16_t u;     // 'u', decimal or 0x hex, 0 to 65535
+    int16_t i;      // 'i', decimal, -32768 to 32767
+    char *s;        // 's', points into the line buffer, valid until the handler returns
+} shellArg_t;
+
+/* Command handler, gets one argument per schema letter */
+typedef void (*shellHandler_t)(const shellArg_t *argv);
+
+/*
+ * Command table entry. The table must be sorted by name (strcmp order) for the binary
+ * search, and schema holds one letter per argument, "" for none, e.g. "us".
+ */
+typedef struct
+{
+    const char *name;
+    const char *schema;
+    shellHandler_t handler;
+} shellCommand_t;
+
+/*
+ *@fn        -   shellInit
+ *
+ *@brief     -   Function to set the command table and clear the line state
+ *
+ *@param[1]  -   Command table sorted by name, usually in __code
+ *@param[2]  -   Number of commands
+ *
+ *return     -   void
+ */
+void shellInit(const shellCommand_t *table, uint8_t count);
+
+/*
+ *@fn        -   shellInput
+ *
+ *@brief     -   Function to feed one received character. The command is looked up when its
+ *               name ends and numbers are converted as their digits arrive, so the end of
+ *               line only checks the argument count and calls the handler. '\r' or '\n'
+ *               ends a line, spaces and tabs separate tokens
+ *
+ *@param[1]  -   Received character
+ *
+ *return     -   uint8_t, SHELL_PENDING until a line ends, then its result
+ */
+uint8_t shellInput(char c);
+
+/*
+ *@fn        -   shellPoll
+ *
+ *@brief     -   Function to feed the shell whatever the UART has received, never blocks.
+ *               Stops after a line completes so the caller can print a prompt
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t, as shellInput
+ */
+uint8_t shellPoll(void);
+
+#endif // AT89S52_SHELL_H
@@ -0,0 +1,108 @@
+#ifndef AT89S52_SPI_H
+#define AT89S52_SPI_H
+
+/*
+ * at89s52_spi.h
+ * Description: This header file contains function declarations for at89s52_spi.c file
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for AT89S52 MCU, contains mnemounics for SFR's
+#include "at89s52.h"
+
+/*
+ * Pins, any __sbit names from at89s52.h. The byte shift is inline assembly that addresses
+ * them as _P1_5 etc., so give the plain names, not GPIO_PIN() or an address.
+ * Chip select is left to the caller, e.g. GPIO_PIN_CLEAR(GPIO_PIN(P1, 4)).
+ */
+#ifndef SPI_MOSI
+#define SPI_MOSI P1_5
+#endif
+
+#ifndef SPI_MISO
+#define SPI_MISO P1_6
+#endif
+
+#ifndef SPI_SCK
+#define SPI_SCK P1_7
+#endif
+
+/*
+ * SPI modes, CPOL is the idle clock level and CPHA 1 samples on the trailing edge, MSB first
+ * in every mode.
+ * The byte shift is straight-line assembly with no branch, so every byte takes exactly 53
+ * machine cycles from its first instruction to RET: 2 to load and rotate, 6 per bit
+ * (MOV bit,C 2, SETB, CLR, MOV C,bit and RLC 1 each) and 3 to return. That clocks 8 bits per
+ * 53 cycles, 151 kbit/s at 12 MHz and 139 kbit/s at 11.0592 MHz, before the per-byte cost of
+ * the spiWrite()/spiRead()/spiExchange() loop and the call through the mode pointer. That part
+ * is compiler output, time it in s51 as README.md describes. `make bench` counts the pin
+ * accesses of each burst, 4 per bit and 32 per byte in every mode, and flags any change.
+ */
+#define SPI_MODE0 0     // CPOL 0, CPHA 0
+#define SPI_MODE1 1     // CPOL 0, CPHA 1
+#define SPI_MODE2 2     // CPOL 1, CPHA 0
+#define SPI_MODE3 3     // CPOL 1, CPHA 1
+
+/*
+ *@fn        -   spiInit
+ *
+ *@brief     -   Function to set the SPI mode and put the pins in their idle state
+ *
+ *@param[1]  -   SPI_MODE0 to SPI_MODE3
+ *
+ *return     -   void
+ */
+void spiInit(uint8_t mode);
+
+/*
+ *@fn        -   spiTransfer
+ *
+ *@brief     -   Function to send one byte and return the byte clocked in at the same time
+ *
+ *@param[1]  -   Byte to send
+ *
+ *return     -   uint8_t
+ */
+uint8_t spiTransfer(uint8_t out);
+
+/*
+ *@fn        -   spiWrite
+ *
+ *@brief     -   Function to send a buffer, the received bytes are discarded
+ *
+ *@param[1]  -   Data reference
+ *@param[2]  -   Number of bytes
+ *
+ *return     -   void
+ */
+void spiWrite(const uint8_t *buf, uint16_t len);
+
+/*
+ *@fn        -   spiRead
+ *
+ *@brief     -   Function to read into a buffer, sends 0xFF for every byte
+ *
+ *@param[1]  -   Buffer reference
+ *@param[2]  -   Number of bytes
+ *
+ *return     -   void
+ */
+void spiRead(uint8_t *buf, uint16_t len);
+
+/*
+ *@fn        -   spiExchange
+ *
+ *@brief     -   Function to send one buffer and receive into another in the same transfer,
+ *               the buffers may be the same
+ *
+ *@param[1]  -   Data to send
+ *@param[2]  -   Buffer for the received data
+ *@param[3]  -   Number of bytes
+ *
+ *return     -   void
+ */
+void spiExchange(const uint8_t *tx, uint8_t *rx, uint16_t len);
+
+#endif // AT89S52_SPI_H
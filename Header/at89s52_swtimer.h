@@ -0,0 +1,115 @@
+#ifndef AT89S52_SWTIMER_H
+#define AT89S52_SWTIMER_H
+
+/*
+ * at89s52_swtimer.h
+ * Description: This header file contains function declarations for at89s52_swtimer.c file
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for the tick the wheel runs from
+#include "at89s52_tick.h"
+
+/* Number of software timers in the pool, at most 254 */
+#ifndef SWTIMER_MAX
+#define SWTIMER_MAX 16
+#endif
+
+/* Wheel slots, must be a power of two. Timers due within this many ticks need no extra rounds */
+#ifndef SWTIMER_SLOTS
+#define SWTIMER_SLOTS 16
+#endif
+
+/* Memory space of the timer pool */
+#ifndef SWTIMER_SPACE
+#define SWTIMER_SPACE __xdata
+#endif
+
+/* Returned by swTimerCreate when the pool is empty */
+#define SWTIMER_NONE 0xFF
+
+/* Expiry callback, runs from the tick ISR with the id of the expired timer */
+typedef void (*swTimerCallback_t)(uint8_t id);
+
+/*
+ *@fn        -   swTimerInit
+ *
+ *@brief     -   Function to clear the timer pool and attach the wheel to the tick
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t, 0 if the tick has no free hook
+ */
+uint8_t swTimerInit(void);
+
+/*
+ *@fn        -   swTimerCreate
+ *
+ *@brief     -   Function to take a timer from the pool
+ *
+ *@param[1]  -   Function to call when the timer expires
+ *
+ *return     -   uint8_t, timer id or SWTIMER_NONE
+ */
+uint8_t swTimerCreate(swTimerCallback_t callback);
+
+/*
+ *@fn        -   swTimerDelete
+ *
+ *@brief     -   Function to stop a timer and return it to the pool
+ *
+ *@param[1]  -   Timer id
+ *
+ *return     -   void
+ */
+void swTimerDelete(uint8_t id);
+
+/*
+ *@fn        -   swTimerStart
+ *
+ *@brief     -   Function to arm a timer, restarts it if it is already running
+ *
+ *@param[1]  -   Timer id
+ *@param[2]  -   Ticks until the first expiry, 0 is treated as 1
+ *@param[3]  -   Ticks between later expiries, 0 for a one-shot timer
+ *
+ *return     -   void
+ */
+void swTimerStart(uint8_t id, uint16_t ticks, uint16_t period) __reentrant;
+
+/*
+ *@fn        -   swTimerStop
+ *
+ *@brief     -   Function to disarm a timer
+ *
+ *@param[1]  -   Timer id
+ *
+ *return     -   void
+ */
+void swTimerStop(uint8_t id) __reentrant;
+
+/*
+ *@fn        -   swTimerActive
+ *
+ *@brief     -   Function to check whether a timer is armed
+ *
+ *@param[1]  -   Timer id
+ *
+ *return     -   uint8_t
+ */
+uint8_t swTimerActive(uint8_t id);
+
+/*
+ *@fn        -   swTimerTick
+ *
+ *@brief     -   Function to advance the wheel one slot, attached to the tick by swTimerInit
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+void swTimerTick(void);
+
+#endif // AT89S52_SWTIMER_H
@@ -0,0 +1,132 @@
+#ifndef AT89S52_TICK_H
+#define AT89S52_TICK_H
+
+/*
+ * at89s52_tick.h
+ * Description: This header file contains function declarations for at89s52_tick.c file
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for timer functions, pulls in the SFR mnemonics
+#include "at89s52_timer.h"
+
+/* Tick period in microseconds */
+#ifndef TICK_PERIOD_US
+#define TICK_PERIOD_US 1000
+#endif
+
+/* Number of functions tickAttach() can register */
+#ifndef TICK_MAX_HOOKS
+#define TICK_MAX_HOOKS 4
+#endif
+
+/* Function run from the tick ISR on every tick */
+typedef void (*tickHook_t)(void);
+
+/* Timer counts per tick, rounded down. 1000 at 12 MHz, 921 at 11.0592 MHz for a 1 ms tick */
+#define TICK_COUNTS ((uint16_t)(((CLOCK_SOURCE / 1200UL) * TICK_PERIOD_US) / 10000UL))
+
+/*
+ * Count fraction TICK_COUNTS drops, in 1/10000 of a count. tickIsr adds one count to a tick each
+ * time the dropped fractions make a whole count, 3 ticks in 5 are 922 counts at 11.0592 MHz, so
+ * the average period is exact instead of 434 ppm slow. Any single tick is within one count
+ */
+#define TICK_FRACTION (((CLOCK_SOURCE / 1200UL) * TICK_PERIOD_US) % 10000UL)
+
+/* Value the timer restarts from after every overflow */
+#define TICK_RELOAD ((uint16_t)(0 - TICK_COUNTS))
+
+/* Registers of the tick timer */
+#if TICK_TIMER == T2
+#define TICK_ET     ET2
+#define TICK_TF     TF2
+#define TICK_TH     TH2
+#define TICK_TL     TL2
+#elif TICK_TIMER == T0
+#define TICK_ET     ET0
+#define TICK_TF     TF0
+#define TICK_TH     TH0
+#define TICK_TL     TL0
+#else
+#error "TICK_TIMER must be T0 or T2"
+#endif
+
+/*
+ * Ticks since tickInit. micros() is not reentrant, an ISR that needs a timestamp reads this
+ * and TICK_TH/TICK_TL itself. Only read it where the tick ISR cannot preempt the reader.
+ */
+extern volatile uint32_t tickCount;
+
+/*
+ *@fn        -   tickInit
+ *
+ *@brief     -   Function to start the free running tick on TICK_TIMER and enable its interrupt
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+void tickInit(void);
+
+/*
+ *@fn        -   tickRunning
+ *
+ *@brief     -   Function to check whether the tick has been started
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t
+ */
+uint8_t tickRunning(void);
+
+/*
+ *@fn        -   tickAttach
+ *
+ *@brief     -   Function to register a function the tick ISR calls on every tick
+ *
+ *@param[1]  -   Function to call, runs in interrupt context
+ *
+ *return     -   uint8_t, 0 if TICK_MAX_HOOKS are already registered
+ */
+uint8_t tickAttach(tickHook_t hook);
+
+/*
+ *@fn        -   millis
+ *
+ *@brief     -   Function to read the milliseconds elapsed since tickInit
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint32_t
+ */
+uint32_t millis(void);
+
+/*
+ *@fn        -   micros
+ *
+ *@brief     -   Function to read the microseconds elapsed since tickInit, includes the live timer count
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint32_t
+ */
+uint32_t micros(void);
+
+/*
+ *@fn        -   tickIsr
+ *
+ *@brief     -   Tick interrupt service routine on the TICK_TIMER vector
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+#if TICK_TIMER == T2
+void tickIsr(void) __interrupt(TIMER2_VECTOR);
+#else
+void tickIsr(void) __interrupt(TIMER0_VECTOR);
+#endif
+
+#endif // AT89S52_TICK_H
@@ -12,15 +12,53 @@
 // Library for AT89S52 MCU, contains mnemounics for SFR's
 #include "at89s52.h"
 
+/*
+ * delay_us()/delay_ms() calibration, in machine cycles.
+ * These are the fixed costs outside the timed window: call, argument compare, timer setup
+ * and the polling granularity of the TF0 loop. They are subtracted from the timer load, so
+ * retune them in s51 when the compiler version or optimisation flags change.
+ */
+#ifndef DELAY_US_OVERHEAD
+#define DELAY_US_OVERHEAD       28  // delay_us() entry to exit around a single timer load
+#endif
+
+#ifndef DELAY_US_MIN_TIMER
+#define DELAY_US_MIN_TIMER      16  // shorter intervals use the DJNZ loop instead of Timer 0
+#endif
+
+#ifndef DELAY_US_LOOP_OVERHEAD
+#define DELAY_US_LOOP_OVERHEAD  14  // delay_us() entry to exit around the DJNZ loop
+#endif
+
+#ifndef DELAY_CHUNK_OVERHEAD
+#define DELAY_CHUNK_OVERHEAD    20  // one iteration of the long span loop in delay_us()
+#endif
+
+#ifndef DELAY_MS_OVERHEAD
+#define DELAY_MS_OVERHEAD       18  // one iteration of the delay_ms() loop
+#endif
+
+/*
+ * Set by a driver that keeps Timer 0 running for itself (at89s52_pwm.c). delay_us() and delay_ms()
+ * then wait on the tick, or count DJNZ loops when the tick is not running, instead of reloading
+ * Timer 0.
+ */
+extern __bit timer0Busy;
+
+/* Run by delay_ms() on every pass while it waits on the tick, e.g. background work or PCON idle */
+#ifndef DELAY_YIELD
+#define DELAY_YIELD()
+#endif
+
 
 /*
  *@fn        -   timerConfig
  *
- *@brief     -   Function to configure the Timer 0 and Timer 1
+ *@brief     -   Function to configure the Timer 0, Timer 1 and Timer 2
  *
- *@param[1]  -   Timer 0 or 1 selection
+ *@param[1]  -   Timer 0, 1 or 2 selection
  *@param[2]  -   Setting it to be Timer or Counter
- *@param[3]  -   Setting the Timer or Counter in 4 diffrent modes
+ *@param[3]  -   TIMER_MODE0 to 3 for Timer 0/1, TIMER2_AUTO_RELOAD/CAPTURE/BAUD_RATE for Timer 2
  *
  *return     -   void
  */
@@ -29,9 +67,10 @@ void timerConfig(uint8_t Tx, uint8_t TorC, uint8_t mode);
 /*
  *@fn        -   timerInterruptConfig
  *
- *@brief     -   Function to config the T0 or T1 has timer interrupt
+ *@brief     -   Function to config the T0, T1 or T2 has timer interrupt,
+ *               Timer 2 runs in 16-bit auto-reload and restarts from count by itself
  *
- *@param[1]  -   Selecting the Timer 0 or 1
+ *@param[1]  -   Selecting the Timer 0, 1 or 2
  *@param[2]	 -	 count value to load
  *@param[2]  -   Enabling or Disabling the mode
  *
@@ -42,9 +81,10 @@ void timerInterruptConfig(uint8_t Tx, uint16_t count, uint8_t mode);
 /*
  *@fn        -   timerLoad
  *
- *@brief     -   Function to load the Timer 0 and Timer 1, TH's and TL's
+ *@brief     -   Function to load the Timer 0, 1 and 2, TH's and TL's.
+ *               Timer 2 also gets the value in RCAP2H/L as its reload
  *
- *@param[1]  -   Selecting the Timer 0 or 1
+ *@param[1]  -   Selecting the Timer 0, 1 or 2
  *@param[2]  -   Loading the value to the TH's and TL's register
  *
  *return     -   void
@@ -54,9 +94,9 @@ void timerLoad(uint8_t Tx, uint16_t load);
 /*
  *@fn        -   timerStart
  *
- *@brief     -   Function to start the Timer 0 or 1
+ *@brief     -   Function to start the Timer 0, 1 or 2
  *
- *@param[1]  -   Selecting the Timer 0 or 1
+ *@param[1]  -   Selecting the Timer 0, 1 or 2
  *
  *return     -   void
  */
@@ -65,9 +105,9 @@ void timerStart(uint8_t Tx);
 /*
  *@fn        -   timerFlag
  *
- *@brief     -   Function to check the flag of Timer 0 or 1
+ *@brief     -   Function to check the flag of Timer 0, 1 or 2
  *
- *@param[1]  -   Selecting the Timer 0 or 1
+ *@param[1]  -   Selecting the Timer 0, 1 or 2
  *
  *return     -   void
  */
@@ -76,20 +116,55 @@ uint8_t timerFlag(uint8_t Tx);
 /*
  *@fn        -   timerStop
  *
- *@brief     -   Function to stop the Timer 0 or 1
+ *@brief     -   Function to stop the Timer 0, 1 or 2
  *
- *@param[1]  -   Selecting the Timer 0 or 1
+ *@param[1]  -   Selecting the Timer 0, 1 or 2
  *
  *return     -   void
  */
 void timerStop(uint8_t Tx);
 
+/*
+ *@fn        -   timer2CaptureRead
+ *
+ *@brief     -   Function to read the Timer 2 count latched by the last T2EX falling edge
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint16_t
+ */
+uint16_t timer2CaptureRead(void);
+
+/*
+ *@fn        -   timer2CaptureFlag
+ *
+ *@brief     -   Function to check whether T2EX latched a new capture since the last read
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t
+ */
+uint8_t timer2CaptureFlag(void);
+
+/*
+ *@fn        -   timer2BaudConfig
+ *
+ *@brief     -   Function to run Timer 2 as the UART receive and transmit baud rate generator,
+ *               baud = CLOCK_SOURCE / (32 * (65536 - reload))
+ *
+ *@param[1]  -   Reload value for RCAP2H/L
+ *
+ *return     -   void
+ */
+void timer2BaudConfig(uint16_t reload);
+
 /*
  *@fn        -   delay_us
  *
- *@brief     -   Function to generate 1us delay
+ *@brief     -   Function to generate a delay in microseconds, busy waits on Timer 0 unless
+ *               the tick or timer0Busy has it
  *
- *@param[1]  -   Takes 1us time
+ *@param[1]  -   Number of microseconds
  *
  *return     -   void
  */
@@ -98,9 +173,11 @@ void delay_us(uint32_t us);
 /*
  *@fn        -   delay_ms
  *
- *@brief     -   Function to generate 1ms delay
+ *@brief     -   Function to generate a delay in milliseconds, busy waits on Timer 0 or,
+ *               once tickInit() has run, yields on millis() without touching the timers.
+ *               With timer0Busy and no tick it counts DJNZ loops like delay_us()
  *
- *@param[1]  -   Takes 1ms time
+ *@param[1]  -   Number of milliseconds
  *
  *return     -   void
  */
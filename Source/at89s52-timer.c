@@ -8,15 +8,42 @@
 
 // Library for function declarations
 #include "at89s52_timer.h"
+// Library for the tick timebase, delays wait on it once it is running
+#include "at89s52_tick.h"
+
+/* Timer counts (machine cycles) per microsecond scaled by 2^16, 65536 at 12 MHz */
+#define DELAY_US_SCALE      (((CLOCK_SOURCE / 1000UL) * 65536UL) / 12000UL)
+
+/* Machine cycles for a number of microseconds, us must not exceed DELAY_US_CHUNK */
+#if CLOCK_SOURCE == 12000000UL
+#define DELAY_US_TICKS(us)  ((uint16_t)(us))
+#else
+#define DELAY_US_TICKS(us)  ((uint16_t)(((uint32_t)(us) * DELAY_US_SCALE) >> 16))
+#endif
+
+/* Machine cycles in 1 ms */
+#define DELAY_MS_TICKS      ((uint16_t)(CLOCK_SOURCE / 12000UL))
+
+/* Largest span handled by one timer load, fits 16 bits up to a 39 MHz crystal */
+#define DELAY_US_CHUNK      20000UL
+
+/* DJNZ loop of 2 machine cycles per pass, the two polls keep the host emulation at 2 cycles too */
+#define DELAY_DJNZ(loops)   do { uint8_t n_ = (loops); while (--n_) { IDLE_POLL(); IDLE_POLL(); } } while (0)
+
+/* Span and DJNZ count of one pass of the loop delay_us() counts when Timer 0 is busy */
+#define DELAY_SPIN_US       100UL
+#define DELAY_SPIN_LOOPS    ((uint8_t)((DELAY_US_TICKS(DELAY_SPIN_US) - DELAY_CHUNK_OVERHEAD) / 2))
+
+__bit timer0Busy;
 
 /*
  *@fn        -   timerConfig
  *
- *@brief     -   Function to configure the Timer 0 and Timer 1
+ *@brief     -   Function to configure the Timer 0, Timer 1 and Timer 2
  *
- *@param[1]  -   Timer 0 or 1 selection
+ *@param[1]  -   Timer 0, 1 or 2 selection
  *@param[2]  -   Setting it to be Timer or Counter
- *@param[3]  -   Setting the Timer or Counter in 4 diffrent modes
+ *@param[3]  -   TIMER_MODE0 to 3 for Timer 0/1, TIMER2_AUTO_RELOAD/CAPTURE/BAUD_RATE for Timer 2
  *
  *return     -   void
  */
@@ -34,16 +61,32 @@ void timerConfig(uint8_t Tx, uint8_t TorC, uint8_t mode)
 	else if(Tx == T1)
 	{
 		TMOD &= 0x0F;
-		TMOD |= Tmod;
+		TMOD |= (Tmod << 4);
+	}
+	else if(Tx == T2)
+	{
+		uint8_t t2con = (TorC << 1);
+
+		if(mode == TIMER2_CAPTURE)
+		{
+			t2con |= 0x09; // CP/RL2 and EXEN2, capture on a T2EX falling edge
+		}
+		else if(mode == TIMER2_BAUD_RATE)
+		{
+			t2con |= 0x30; // RCLK and TCLK
+		}
+
+		T2CON = (T2CON & 0x04) | t2con; // Keep TR2
 	}
 }
 
 /*
  *@fn        -   timerInterruptConfig
  *
- *@brief     -   Function to config the T0 or T1 has timer interrupt
+ *@brief     -   Function to config the T0, T1 or T2 has timer interrupt,
+ *               Timer 2 runs in 16-bit auto-reload and restarts from count by itself
  *
- *@param[1]  -   Selecting the Timer 0 or 1
+ *@param[1]  -   Selecting the Timer 0, 1 or 2
  *@param[2]	 -	 count value to load
  *@param[2]  -   Enabling or Disabling the mode
  *
@@ -75,6 +118,19 @@ void timerInterruptConfig(uint8_t Tx, uint16_t count, uint8_t mode)
 			ET1 = 1;
 			TR1 = 1;
 		}
+		else if(Tx == T2)
+		{
+			TR2 = 0;
+			T2CON = 0x00;
+
+			RCAP2L = count & 0xFF;
+			RCAP2H = (count >> 8) & 0xFF;
+			TL2 = count & 0xFF;
+			TH2 = (count >> 8) & 0xFF;
+
+			ET2 = 1;
+			TR2 = 1;
+		}
 
 		EA = 1;
 	}
@@ -90,6 +146,11 @@ void timerInterruptConfig(uint8_t Tx, uint16_t count, uint8_t mode)
 			ET1 = 0;
 			TR1 = 1;
 		}
+		else if(Tx == T2)
+		{
+			ET2 = 0;
+			TR2 = 0;
+		}
 
 		EA = 0;
 	}
@@ -99,9 +160,10 @@ void timerInterruptConfig(uint8_t Tx, uint16_t count, uint8_t mode)
 /*
  *@fn        -   timerLoad
  *
- *@brief     -   Function to load the Timer 0 and Timer 1, TH's and TL's
+ *@brief     -   Function to load the Timer 0, 1 and 2, TH's and TL's.
+ *               Timer 2 also gets the value in RCAP2H/L as its reload
  *
- *@param[1]  -   Selecting the Timer 0 or 1
+ *@param[1]  -   Selecting the Timer 0, 1 or 2
  *@param[2]  -   Loading the value to the TH's and TL's register
  *
  *return     -   void
@@ -118,14 +180,21 @@ void timerLoad(uint8_t Tx, uint16_t load)
 		TL1 = load & 0xFF;
 		TH1 = (load >> 8) & 0xFF;
 	}
+	else if(Tx == T2)
+	{
+		RCAP2L = load & 0xFF;
+		RCAP2H = (load >> 8) & 0xFF;
+		TL2 = load & 0xFF;
+		TH2 = (load >> 8) & 0xFF;
+	}
 }
 
 /*
  *@fn        -   timerStart
  *
- *@brief     -   Function to start the Timer 0 or 1
+ *@brief     -   Function to start the Timer 0, 1 or 2
  *
- *@param[1]  -   Selecting the Timer 0 or 1
+ *@param[1]  -   Selecting the Timer 0, 1 or 2
  *
  *return     -   void
  */
@@ -139,14 +208,18 @@ void timerStart(uint8_t Tx)
 	{
 		TR1 = 1;
 	}
+	else if(Tx == T2)
+	{
+		TR2 = 1;
+	}
 }
 
 /*
  *@fn        -   timerFlag
  *
- *@brief     -   Function to check the flag of Timer 0 or 1
+ *@brief     -   Function to check the flag of Timer 0, 1 or 2
  *
-TCON |= (1 << 6); *@param[1]  -   Selecting the Timer 0 or 1
+TCON |= (1 << 6); *@param[1]  -   Selecting the Timer 0, 1 or 2
  *
  *return     -   void
  */
@@ -174,6 +247,17 @@ uint8_t timerFlag(uint8_t Tx)
 			return 0;
 		}
 	}
+	else if(Tx == T2)
+	{
+		if(TF2 & 1)
+		{
+			return 1;
+		}
+		else
+		{
+			return 0;
+		}
+	}
 
 	return 0;
 }
@@ -181,9 +265,9 @@ uint8_t timerFlag(uint8_t Tx)
 /*
  *@fn        -   timerStop
  *
- *@brief     -   Function to stop the Timer 0 or 1
+ *@brief     -   Function to stop the Timer 0, 1 or 2
  *
- *@param[1]  -   Selecting the Timer 0 or 1
+ *@param[1]  -   Selecting the Timer 0, 1 or 2
  *
  *return     -   void
  */
@@ -199,76 +283,207 @@ void timerStop(uint8_t Tx)
 		TR1 = 0;
 		TF1 = 0;
 	}
+	else if(Tx == T2)
+	{
+		TR2 = 0;
+		TF2 = 0;
+		EXF2 = 0;
+	}
 }
 
 /*
- *@fn        -   delay_us
+ *@fn        -   timer2CaptureRead
+ *
+ *@brief     -   Function to read the Timer 2 count latched by the last T2EX falling edge
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint16_t
+ */
+uint16_t timer2CaptureRead(void)
+{
+	uint8_t hi, lo;
+
+	// A new edge may land between the two byte reads, read again until both agree
+	do
+	{
+		EXF2 = 0;
+		lo = RCAP2L;
+		hi = RCAP2H;
+	} while(EXF2);
+
+	return ((uint16_t)hi << 8) | lo;
+}
+
+/*
+ *@fn        -   timer2CaptureFlag
+ *
+ *@brief     -   Function to check whether T2EX latched a new capture since the last read
+ *
+ *@param[1]  -   void
  *
- *@brief     -   Function to generate 1us delay
+ *return     -   uint8_t
+ */
+uint8_t timer2CaptureFlag(void)
+{
+	return EXF2 ? 1 : 0;
+}
+
+/*
+ *@fn        -   timer2BaudConfig
+ *
+ *@brief     -   Function to run Timer 2 as the UART receive and transmit baud rate generator,
+ *               baud = CLOCK_SOURCE / (32 * (65536 - reload))
  *
- *@param[1]  -   Takes 1us time
+ *@param[1]  -   Reload value for RCAP2H/L
  *
  *return     -   void
  */
-void delay_us(uint32_t us)
+void timer2BaudConfig(uint16_t reload)
+{
+	TR2 = 0;
+	ET2 = 0;
+	T2CON = 0x30; // RCLK and TCLK, timer, no T2EX events
+
+	RCAP2L = reload & 0xFF;
+	RCAP2H = (reload >> 8) & 0xFF;
+	TL2 = reload & 0xFF;
+	TH2 = (reload >> 8) & 0xFF;
+
+	TR2 = 1;
+}
+
+/*
+ *@fn        -   delayTicks
+ *
+ *@brief     -   Function to run Timer 0 once for a number of machine cycles
+ *
+ *@param[1]  -   Machine cycles (timer counts) to wait, 1 to 65535
+ *
+ *return     -   void
+ */
+static void delayTicks(uint16_t ticks)
 {
-    // Calculate the timer value
-    uint16_t count = ((1 * CLOCK_SOURCE) / (1000000 * 12));
-    count = (65536 - count);
+    ticks = 0 - ticks; // Timer counts up from (65536 - ticks) to the overflow
 
+    TR0 = 0;
     TMOD &= 0xF0;
     TMOD |= 0x01;
 
-    while(us > 0)
+    TH0 = (ticks >> 8) & 0xFF;
+    TL0 = ticks & 0xFF;
+    TF0 = 0;
+    TR0 = 1;
+
+    while (!TF0);   // Wait until TF0 (Timer 0 Overflow Flag) is set
+
+    TR0 = 0;
+    TF0 = 0;
+}
+
+/*
+ *@fn        -   delay_us
+ *
+ *@brief     -   Function to generate a delay in microseconds
+ *
+ *@param[1]  -   Number of microseconds
+ *
+ *return     -   void
+ */
+void delay_us(uint32_t us)
+{
+    uint16_t ticks;
+
+#if TICK_TIMER == T0
+    if (tickRunning())
+#else
+    if (timer0Busy && tickRunning())
+#endif
     {
-        // Load the Timer 0
-        TH0 = (count >> 8) & 0xFF;  // Load higher byte of count
-        TL0 = count & 0xFF;  // Load lower byte of count
+        // Timer 0 belongs to another driver, wait on the timebase instead of reloading it
+        uint32_t start = micros();
+        while ((uint32_t)(micros() - start) < us);
+        return;
+    }
 
-        // Start Timer 0
-        TR0 = 1;  // Set TR0 (Timer 0 Run Control) bit to 1
+    if (timer0Busy)
+    {
+        // No timebase to wait on either, count DJNZ loops. Interrupts only make this longer
+        while (us >= DELAY_SPIN_US)
+        {
+            DELAY_DJNZ(DELAY_SPIN_LOOPS);
+            us -= DELAY_SPIN_US;
+        }
+        ticks = DELAY_US_TICKS(us);
+        if (ticks > DELAY_US_LOOP_OVERHEAD + 1)
+        {
+            DELAY_DJNZ((uint8_t)((ticks - DELAY_US_LOOP_OVERHEAD) >> 1));
+        }
+        return;
+    }
+
+    // Long spans run as whole timer loads, the chunk overhead is taken out of each load
+    while (us > DELAY_US_CHUNK)
+    {
+        delayTicks(DELAY_US_TICKS(DELAY_US_CHUNK) - DELAY_CHUNK_OVERHEAD);
+        us -= DELAY_US_CHUNK;
+    }
 
-        while (!TF0);   // Wait until TF0 (Timer 0 Overflow Flag) is set
+    ticks = DELAY_US_TICKS(us);
 
-        // Stop Timer 0
-        TR0 = 0;  // Clear TR0 bit to 0
-        TF0 = 0;  // Clear TF0 bit to 0
-        us--;
-    } 
+    if (ticks > DELAY_US_OVERHEAD + DELAY_US_MIN_TIMER)
+    {
+        // One timer load for the whole interval
+        delayTicks(ticks - DELAY_US_OVERHEAD);
+    }
+    else if (ticks > DELAY_US_LOOP_OVERHEAD + 1)
+    {
+        // Too short for the timer, count DJNZ iterations of 2 machine cycles each
+        DELAY_DJNZ((uint8_t)((ticks - DELAY_US_LOOP_OVERHEAD) >> 1));
+    }
+    // else the call itself already took longer than requested
 }
 
 /*
  *@fn        -   delay_ms
  *
- *@brief     -   Function to generate 1ms delay
+ *@brief     -   Function to generate a delay in milliseconds
  *
- *@param[1]  -   Takes 1ms time
+ *@param[1]  -   Number of milliseconds
  *
  *return     -   void
  */
 void delay_ms(uint32_t ms)
 {
-    // Calculate the timer value
-    uint16_t count = ((1 * CLOCK_SOURCE) / (1000 * 12));
-    count = (65536 - count);
-
-    TMOD &= 0xF0;
-    TMOD |= 0x01;
-
-    while(ms > 0)
+    if (tickRunning())
     {
-        // Load the Timer 0
-        TH0 = (count >> 8) & 0xFF;  // Load higher byte of count
-        TL0 = count & 0xFF;  // Load lower byte of count
-
-        // Start Timer 0
-        TR0 = 1;  // Set TR0 (Timer 0 Run Control) bit to 1
+        // Leave the timers alone and yield until the tick has counted ms full milliseconds
+        uint32_t start = millis();
+        if (ms == 0)
+        {
+            return;
+        }
+        while ((uint32_t)(millis() - start) <= ms)
+        {
+            DELAY_YIELD();
+        }
+        return;
+    }
 
-        while (!TF0);   // Wait until TF0 (Timer 0 Overflow Flag) is set
+    if (timer0Busy)
+    {
+        // Timer 0 belongs to another driver and its ISR takes TF0, spin in delay_us instead
+        while (ms > 0)
+        {
+            delay_us(1000);
+            ms--;
+        }
+        return;
+    }
 
-        // Stop Timer 0
-        TR0 = 0;  // Clear TR0 bit to 0
-        TF0 = 0;  // Clear TF0 bit to 0
+    while (ms > 0)
+    {
+        delayTicks(DELAY_MS_TICKS - DELAY_MS_OVERHEAD);
         ms--;
     }
 }
@@ -0,0 +1,193 @@
+/*
+ * at89s52_debounce.c
+ * Description: This file contains the port debouncer. Each port is sampled from the tick and
+ *              its 8 pins are debounced together with vertical counters, one counter bit
+ *              per byte so a few logic instructions count all pins at once.
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for function declarations
+#include "at89s52_debounce.h"
+// Library for the port reads and the input setup
+#include "at89s52_gpio.h"
+
+static uint8_t channels;
+static uint8_t ports[DEBOUNCE_MAX_PORTS];
+static uint8_t masks[DEBOUNCE_MAX_PORTS];
+static uint8_t state[DEBOUNCE_MAX_PORTS];       // debounced, 1 = pressed
+static uint8_t count0[DEBOUNCE_MAX_PORTS];      // bit 0 of each pin's counter
+static uint8_t count1[DEBOUNCE_MAX_PORTS];      // bit 1 of each pin's counter
+static volatile uint8_t pressed[DEBOUNCE_MAX_PORTS];
+static volatile uint8_t released[DEBOUNCE_MAX_PORTS];
+static uint8_t divider;
+
+/*
+ *@fn        -   debounceTick
+ *
+ *@brief     -   Tick hook, samples every DEBOUNCE_TICKS ticks
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void debounceTick(void)
+{
+    if (++divider >= DEBOUNCE_TICKS)
+    {
+        divider = 0;
+        debounceSample();
+    }
+}
+
+/*
+ *@fn        -   debounceInit
+ *
+ *@brief     -   Function to clear the channels and attach the sampling to the tick
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t, 0 if the tick has no free hook
+ */
+uint8_t debounceInit(void)
+{
+    channels = 0;
+    divider = 0;
+
+    return tickAttach(debounceTick);
+}
+
+/*
+ *@fn        -   debounceAdd
+ *
+ *@brief     -   Function to debounce pins of a port
+ *
+ *@param[1]  -   GPIO ports selection
+ *@param[2]  -   Pins to debounce
+ *
+ *return     -   uint8_t, channel number or DEBOUNCE_NONE if all channels are used
+ */
+uint8_t debounceAdd(uint8_t port, uint8_t mask)
+{
+    uint8_t ch = channels;
+
+    if (ch == DEBOUNCE_MAX_PORTS)
+    {
+        return DEBOUNCE_NONE;
+    }
+
+    // Latch 1 makes the pins inputs with the internal pull-up
+    gpioPortSetClear(port, mask, 0);
+
+    ports[ch] = port;
+    masks[ch] = mask;
+    state[ch] = 0;
+    count0[ch] = 0xFF;
+    count1[ch] = 0xFF;
+    pressed[ch] = 0;
+    released[ch] = 0;
+
+    // Publish the channel after it is set up, the tick may sample at any time
+    channels = ch + 1;
+    return ch;
+}
+
+/*
+ *@fn        -   debounceSample
+ *
+ *@brief     -   Function to take one sample of every channel
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+void debounceSample(void)
+{
+    uint8_t ch;
+    uint8_t change;
+
+    for (ch = 0; ch < channels; ch++)
+    {
+        // Pins that differ from the debounced state, active low. gpioPortRead keeps its
+        // argument in registers, so calling it from the tick ISR does not clash with main
+        change = (state[ch] ^ ~gpioPortRead(ports[ch])) & masks[ch];
+
+        // 2 bit down counters, reset where the pin agrees with the state, wrap after 4 samples
+        count0[ch] = ~(count0[ch] & change);
+        count1[ch] = count0[ch] ^ (count1[ch] & change);
+        change &= count0[ch] & count1[ch];
+
+        state[ch] ^= change;
+        pressed[ch] |= state[ch] & change;
+        released[ch] |= ~state[ch] & change;
+    }
+}
+
+/*
+ *@fn        -   debounceState
+ *
+ *@brief     -   Function to get the debounced state of a channel, 1 for a pressed pin
+ *
+ *@param[1]  -   Channel number
+ *
+ *return     -   uint8_t
+ */
+uint8_t debounceState(uint8_t channel)
+{
+    return (channel < channels) ? state[channel] : 0;
+}
+
+/*
+ *@fn        -   debouncePressed
+ *
+ *@brief     -   Function to take the pins pressed since the last call
+ *
+ *@param[1]  -   Channel number
+ *
+ *return     -   uint8_t, pin mask
+ */
+uint8_t debouncePressed(uint8_t channel)
+{
+    uint8_t mask;
+    uint8_t ea = EA;
+
+    if (channel >= channels)
+    {
+        return 0;
+    }
+
+    EA = 0;
+    mask = pressed[channel];
+    pressed[channel] = 0;
+    EA = ea;
+
+    return mask;
+}
+
+/*
+ *@fn        -   debounceReleased
+ *
+ *@brief     -   Function to take the pins released since the last call
+ *
+ *@param[1]  -   Channel number
+ *
+ *return     -   uint8_t, pin mask
+ */
+uint8_t debounceReleased(uint8_t channel)
+{
+    uint8_t mask;
+    uint8_t ea = EA;
+
+    if (channel >= channels)
+    {
+        return 0;
+    }
+
+    EA = 0;
+    mask = released[channel];
+    released[channel] = 0;
+    EA = ea;
+
+    return mask;
+}
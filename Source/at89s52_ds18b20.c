@@ -0,0 +1,121 @@
+/*
+ * at89s52_ds18b20.c
+ * Description: This file contains the DS18B20 temperature sensor driver. A conversion is
+ *              started and then polled from the main loop instead of waiting 750 ms.
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for function declarations
+#include "at89s52_ds18b20.h"
+
+// Library for millis
+#include "at89s52_tick.h"
+
+/* millis() when the running conversion started */
+static uint32_t convertStart;
+
+/* Set from ds18b20Start until ds18b20Ready sees the conversion finish */
+static __bit convertBusy;
+
+/*
+ *@fn        -   ds18b20Start
+ *
+ *@brief     -   Function to start a temperature conversion and return at once
+ *
+ *@param[1]  -   ROM code of the sensor, 0 for every sensor
+ *
+ *return     -   uint8_t, ONEWIRE_OK or ONEWIRE_NO_DEVICE
+ */
+uint8_t ds18b20Start(const uint8_t *rom)
+{
+    if (onewireSelect(rom) != ONEWIRE_OK)
+    {
+        return ONEWIRE_NO_DEVICE;
+    }
+
+    onewireWriteByte(DS18B20_CONVERT_T);
+    convertStart = millis();
+    convertBusy = 1;
+
+    return ONEWIRE_OK;
+}
+
+/*
+ *@fn        -   ds18b20Ready
+ *
+ *@brief     -   Function to check whether the conversion has finished
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t, 1 when done or when no conversion is running
+ */
+uint8_t ds18b20Ready(void)
+{
+    if (!convertBusy)
+    {
+        return 1;
+    }
+
+#ifndef DS18B20_PARASITE
+    // A powered sensor answers read slots with 0 until the result is in the scratchpad
+    if (onewireReadBit())
+    {
+        convertBusy = 0;
+        return 1;
+    }
+#endif
+
+    if ((uint32_t)(millis() - convertStart) >= DS18B20_CONVERT_MS)
+    {
+        convertBusy = 0;
+        return 1;
+    }
+
+    return 0;
+}
+
+/*
+ *@fn        -   ds18b20Read
+ *
+ *@brief     -   Function to read the last converted temperature from the scratchpad, a
+ *               scratchpad with a bad CRC or configuration byte is a ONEWIRE_CRC_ERROR
+ *
+ *@param[1]  -   ROM code of the sensor, 0 when it is the only device on the bus
+ *@param[2]  -   Reference to store the temperature in 1/16 degree Celsius
+ *
+ *return     -   uint8_t, ONEWIRE_OK, ONEWIRE_NO_DEVICE or ONEWIRE_CRC_ERROR
+ */
+uint8_t ds18b20Read(const uint8_t *rom, int16_t *temp)
+{
+    uint8_t pad[DS18B20_SCRATCHPAD_SIZE];
+    uint8_t i;
+
+    if (onewireSelect(rom) != ONEWIRE_OK)
+    {
+        return ONEWIRE_NO_DEVICE;
+    }
+
+    onewireWriteByte(DS18B20_READ_SCRATCHPAD);
+    for (i = 0; i < DS18B20_SCRATCHPAD_SIZE; i++)
+    {
+        pad[i] = onewireReadByte();
+    }
+
+    // A sensor that dropped off after the presence pulse reads as all ones, which fails here too
+    if (onewireCrc8(0, pad, DS18B20_SCRATCHPAD_SIZE) != 0)
+    {
+        return ONEWIRE_CRC_ERROR;
+    }
+
+    // A bus held low reads as all zeros and its CRC is 0 as well, the fixed config bits catch it
+    if ((pad[4] & DS18B20_CONFIG_FIXED_MASK) != DS18B20_CONFIG_FIXED)
+    {
+        return ONEWIRE_CRC_ERROR;
+    }
+
+    *temp = (int16_t)(((uint16_t)pad[1] << 8) | pad[0]);
+
+    return ONEWIRE_OK;
+}
@@ -0,0 +1,221 @@
+/*
+ * at89s52_edge.c
+ * Description: This file contains the INT0/INT1 edge capture. The ISRs timestamp each falling
+ *              edge and push it to a single producer, single consumer queue for the main loop.
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for function declarations
+#include "at89s52_edge.h"
+
+#define EDGE_QUEUE_MASK (EDGE_QUEUE_SIZE - 1)
+
+/* Compile time check, indexes are free running uint8_t so the size must be a power of two <= 128 */
+typedef char edgeQueueSizeCheck[((EDGE_QUEUE_SIZE & EDGE_QUEUE_MASK) == 0 && EDGE_QUEUE_SIZE <= 128) ? 1 : -1];
+
+/* Microseconds per timer count scaled by 2^16, as in micros() */
+#define EDGE_US_SCALE ((12000UL * 65536UL) / (CLOCK_SOURCE / 1000UL))
+
+/* Head is written only by the ISRs and tail only by edgeRead */
+static EDGE_QUEUE_SPACE edgeEvent_t queue[EDGE_QUEUE_SIZE];
+static volatile uint8_t head, tail;
+static volatile uint16_t overflows;
+
+/*
+ * Expanded in each ISR instead of a shared function, an ISR calling a non-reentrant function
+ * would need the whole register bank saved. The timer is read first, closest to the edge.
+ */
+#define EDGE_CAPTURE(src)                                                       \
+    do {                                                                        \
+        uint8_t hi, lo;                                                         \
+        uint16_t counts;                                                        \
+        uint16_t ticks;                                                         \
+        EDGE_QUEUE_SPACE edgeEvent_t *event;                                    \
+        do                                                                      \
+        {                                                                       \
+            hi = TICK_TH;                                                       \
+            lo = TICK_TL;                                                       \
+        } while (hi != TICK_TH);                                                \
+        ticks = (uint16_t)tickCount;                                            \
+        counts = (((uint16_t)hi << 8) | lo) - TICK_RELOAD;                      \
+        if (TICK_TF && counts < (TICK_COUNTS / 2))                              \
+        {                                                                       \
+            ticks++; /* wrapped, tick not serviced yet */                       \
+        }                                                                       \
+        if ((uint8_t)(head - tail) == EDGE_QUEUE_SIZE)                          \
+        {                                                                       \
+            overflows++;                                                        \
+            break;                                                              \
+        }                                                                       \
+        event = &queue[head & EDGE_QUEUE_MASK];                                 \
+        event->source = (src);                                                  \
+        event->ticks = ticks;                                                   \
+        event->counts = counts;                                                 \
+        head++;                                                                 \
+    } while (0)
+
+/*
+ *@fn        -   edgeInit
+ *
+ *@brief     -   Function to start capturing falling edges of an external interrupt pin
+ *
+ *@param[1]  -   INT0_VECTOR or INT1_VECTOR
+ *
+ *return     -   void
+ */
+void edgeInit(uint8_t INTx)
+{
+    // Edge triggered, IEx latches the edge until the ISR runs
+    if (INTx == INT0_VECTOR)
+    {
+        IE0 = 0;
+        IT0 = FALLING;
+        EX0 = ENABLE;
+    }
+    else if (INTx == INT1_VECTOR)
+    {
+        IE1 = 0;
+        IT1 = FALLING;
+        EX1 = ENABLE;
+    }
+    EA = ENABLE;
+}
+
+/*
+ *@fn        -   edgeStop
+ *
+ *@brief     -   Function to stop capturing an external interrupt pin, queued events stay
+ *
+ *@param[1]  -   INT0_VECTOR or INT1_VECTOR
+ *
+ *return     -   void
+ */
+void edgeStop(uint8_t INTx)
+{
+    if (INTx == INT0_VECTOR)
+    {
+        EX0 = 0;
+    }
+    else if (INTx == INT1_VECTOR)
+    {
+        EX1 = 0;
+    }
+}
+
+/*
+ *@fn        -   edgeRead
+ *
+ *@brief     -   Function to take the oldest event from the queue, never blocks
+ *
+ *@param[1]  -   Reference to store the event
+ *
+ *return     -   uint8_t, 1 if an event was read else 0
+ */
+uint8_t edgeRead(edgeEvent_t *event)
+{
+    EDGE_QUEUE_SPACE edgeEvent_t *slot;
+
+    if (head == tail)
+    {
+        return 0;
+    }
+
+    // Copy before moving tail, the slot belongs to the ISRs again after that
+    slot = &queue[tail & EDGE_QUEUE_MASK];
+    event->source = slot->source;
+    event->ticks = slot->ticks;
+    event->counts = slot->counts;
+    tail++;
+    return 1;
+}
+
+/*
+ *@fn        -   edgeAvailable
+ *
+ *@brief     -   Function to get the number of events waiting in the queue
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t
+ */
+uint8_t edgeAvailable(void)
+{
+    return (uint8_t)(head - tail);
+}
+
+/*
+ *@fn        -   edgeOverflows
+ *
+ *@brief     -   Function to get the number of edges lost because the queue was full
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint16_t
+ */
+uint16_t edgeOverflows(void)
+{
+    uint16_t count;
+    uint8_t ea = EA;
+
+    EA = 0;
+    count = overflows;
+    EA = ea;
+
+    return count;
+}
+
+/*
+ *@fn        -   edgeDelta
+ *
+ *@brief     -   Function to get the time between two events
+ *
+ *@param[1]  -   Earlier event
+ *@param[2]  -   Later event, less than 65536 ticks after the earlier one
+ *
+ *return     -   uint32_t, in microseconds
+ */
+uint32_t edgeDelta(const edgeEvent_t *from, const edgeEvent_t *to)
+{
+    uint16_t ticks = to->ticks - from->ticks;
+    int32_t counts = (int32_t)to->counts - (int32_t)from->counts;
+
+#if CLOCK_SOURCE != 12000000UL
+    counts = (counts * (int32_t)EDGE_US_SCALE) >> 16;
+#endif
+
+    return (uint32_t)ticks * TICK_PERIOD_US + counts;
+}
+
+#if EDGE_USE_INT0
+/*
+ *@fn        -   edgeInt0Isr
+ *
+ *@brief     -   INT0 interrupt service routine, queues a timestamped event
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+void edgeInt0Isr(void) __interrupt(INT0_VECTOR)
+{
+    EDGE_CAPTURE(INT0_VECTOR);
+}
+#endif
+
+#if EDGE_USE_INT1
+/*
+ *@fn        -   edgeInt1Isr
+ *
+ *@brief     -   INT1 interrupt service routine, queues a timestamped event
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+void edgeInt1Isr(void) __interrupt(INT1_VECTOR)
+{
+    EDGE_CAPTURE(INT1_VECTOR);
+}
+#endif
@@ -0,0 +1,381 @@
+/*
+ * at89s52_format.c
+ * Description: This file contains a small printf engine for the 8051. It allocates nothing,
+ *              looks conversions up in a table and converts numbers by subtracting powers of
+ *              ten, so no 16/32-bit division routine is pulled in.
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for function declarations
+#include "at89s52_format.h"
+
+/* Conversion flags */
+#define CONV_SIGNED     0x01
+#define CONV_HEX        0x02
+#define CONV_UPPER      0x04
+#define CONV_FIXED      0x08
+#define CONV_CHAR       0x10
+#define CONV_STRING     0x20
+#define CONV_PERCENT    0x40
+#define CONV_UNSIGNED   0x80
+
+/* Field flags */
+#define FIELD_LEFT      0x01
+#define FIELD_ZERO      0x02
+#define FIELD_LONG      0x04
+
+typedef struct
+{
+    char letter;
+    uint8_t flags;
+} formatConv_t;
+
+static const __code formatConv_t convTable[] =
+{
+    { 'd', CONV_SIGNED },
+    { 'i', CONV_SIGNED },
+    { 'u', CONV_UNSIGNED },
+    { 'x', CONV_HEX },
+    { 'X', CONV_HEX | CONV_UPPER },
+    { 'k', CONV_SIGNED | CONV_FIXED },
+    { 'c', CONV_CHAR },
+    { 's', CONV_STRING },
+    { '%', CONV_PERCENT },
+};
+
+static const __code uint32_t pow10Long[6] = { 1000000000UL, 100000000UL, 10000000UL, 1000000UL, 100000UL, 10000UL };
+static const __code uint16_t pow10Int[5] = { 10000, 1000, 100, 10, 1 };
+static const __code char hexDigits[16] = { '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f' };
+
+/*
+ *@fn        -   formatDecimal
+ *
+ *@brief     -   Function to convert a value to decimal digits by subtracting powers of ten
+ *
+ *@param[1]  -   Value to convert
+ *@param[2]  -   Buffer for at least 10 digits, not terminated
+ *
+ *return     -   uint8_t, number of digits
+ */
+static uint8_t formatDecimal(uint32_t value, char *buf)
+{
+    uint8_t len = 0;
+    uint8_t i = 0;
+    uint16_t small;
+    char digit;
+
+    if (value > 0xFFFF)
+    {
+        // 32-bit steps until the rest is below 10000 and fits 16 bits
+        for (i = 0; i < 6; i++)
+        {
+            digit = '0';
+            while (value >= pow10Long[i])
+            {
+                value -= pow10Long[i];
+                digit++;
+            }
+            if (len || digit != '0')
+            {
+                buf[len++] = digit;
+            }
+        }
+        i = 1;
+    }
+
+    small = (uint16_t)value;
+    for (; i < 5; i++)
+    {
+        digit = '0';
+        while (small >= pow10Int[i])
+        {
+            small -= pow10Int[i];
+            digit++;
+        }
+        if (len || digit != '0' || i == 4)
+        {
+            buf[len++] = digit;
+        }
+    }
+
+    return len;
+}
+
+/*
+ *@fn        -   formatHex
+ *
+ *@brief     -   Function to convert a value to hex digits, one nibble at a time
+ *
+ *@param[1]  -   Value to convert
+ *@param[2]  -   Buffer for at least 8 digits, not terminated
+ *@param[3]  -   Non-zero for upper case letters
+ *
+ *return     -   uint8_t, number of digits
+ */
+static uint8_t formatHex(uint32_t value, char *buf, uint8_t upper)
+{
+    uint8_t len = 0;
+    uint8_t shift = 28;
+    char digit;
+
+    while (1)
+    {
+        digit = hexDigits[(uint8_t)(value >> shift) & 0x0F];
+        if (len || digit != '0' || shift == 0)
+        {
+            buf[len++] = (upper && digit > '9') ? digit - ('a' - 'A') : digit;
+        }
+        if (shift == 0)
+        {
+            break;
+        }
+        shift -= 4;
+    }
+
+    return len;
+}
+
+/*
+ *@fn        -   formatPad
+ *
+ *@brief     -   Function to send a character to the sink a number of times
+ *
+ *@param[1]  -   Sink
+ *@param[2]  -   Character to send
+ *@param[3]  -   Count
+ *
+ *return     -   void
+ */
+static void formatPad(formatSink_t sink, uint8_t c, uint8_t count)
+{
+    while (count--)
+    {
+        sink(c);
+    }
+}
+
+/*
+ *@fn        -   formatPrintV
+ *
+ *@brief     -   Function to format a string into a sink from a va_list, see formatPrint
+ *
+ *@param[1]  -   Function that takes each output character
+ *@param[2]  -   Format string
+ *@param[3]  -   Argument list
+ *
+ *return     -   void
+ */
+void formatPrintV(formatSink_t sink, const char *fmt, va_list args)
+{
+    char digits[12];
+    uint8_t i, len, conv, field, width, precision, pad;
+    uint8_t dot;
+    char sign;
+    const char *str;
+    uint32_t value;
+
+    for (; *fmt != '\0'; fmt++)
+    {
+        if (*fmt != '%')
+        {
+            sink(*fmt);
+            continue;
+        }
+        fmt++;
+
+        // Flags, width, precision and length
+        field = 0;
+        width = 0;
+        precision = 0;
+        while (*fmt == '-' || *fmt == '0')
+        {
+            field |= (*fmt == '-') ? FIELD_LEFT : FIELD_ZERO;
+            fmt++;
+        }
+        while (*fmt >= '0' && *fmt <= '9')
+        {
+            width = width * 10 + (*fmt++ - '0');
+        }
+        if (*fmt == '.')
+        {
+            fmt++;
+            while (*fmt >= '0' && *fmt <= '9')
+            {
+                precision = precision * 10 + (*fmt++ - '0');
+            }
+        }
+        if (*fmt == 'l')
+        {
+            field |= FIELD_LONG;
+            fmt++;
+        }
+
+        conv = 0;
+        for (i = 0; i < sizeof(convTable) / sizeof(convTable[0]); i++)
+        {
+            if (convTable[i].letter == *fmt)
+            {
+                conv = convTable[i].flags;
+                break;
+            }
+        }
+
+        if (conv == 0)
+        {
+            // Unknown conversion, print it as written
+            if (*fmt == '\0')
+            {
+                sink('%');
+                return;
+            }
+            sink('%');
+            sink(*fmt);
+            continue;
+        }
+
+        if (conv & CONV_PERCENT)
+        {
+            sink('%');
+            continue;
+        }
+
+        if (conv & CONV_CHAR)
+        {
+            pad = width > 1 ? width - 1 : 0;
+            if (!(field & FIELD_LEFT))
+            {
+                formatPad(sink, ' ', pad);
+            }
+            sink((uint8_t)va_arg(args, int));
+            if (field & FIELD_LEFT)
+            {
+                formatPad(sink, ' ', pad);
+            }
+            continue;
+        }
+
+        if (conv & CONV_STRING)
+        {
+            str = va_arg(args, const char *);
+            for (len = 0; str[len] != '\0' && len < 255; len++);
+            pad = width > len ? width - len : 0;
+            if (!(field & FIELD_LEFT))
+            {
+                formatPad(sink, ' ', pad);
+            }
+            while (*str != '\0')
+            {
+                sink(*str++);
+            }
+            if (field & FIELD_LEFT)
+            {
+                formatPad(sink, ' ', pad);
+            }
+            continue;
+        }
+
+        // Numbers: fetch as the promoted type, keep the magnitude and the sign apart
+        sign = 0;
+        if (field & FIELD_LONG)
+        {
+            value = va_arg(args, unsigned long);
+            if ((conv & CONV_SIGNED) && (int32_t)value < 0)
+            {
+                sign = '-';
+                value = 0UL - value;
+            }
+        }
+        else if (conv & CONV_SIGNED)
+        {
+            int v = va_arg(args, int);
+            value = (uint32_t)(int32_t)v;
+            if (v < 0)
+            {
+                sign = '-';
+                value = 0UL - value;
+            }
+        }
+        else
+        {
+            value = va_arg(args, unsigned int);
+        }
+
+        if (conv & CONV_HEX)
+        {
+            len = formatHex(value, digits, conv & CONV_UPPER);
+        }
+        else
+        {
+            len = formatDecimal(value, digits);
+        }
+
+        // Fixed-point needs at least one integer digit in front of the fraction
+        dot = 0;
+        if ((conv & CONV_FIXED) && precision)
+        {
+            if (precision > 9)
+            {
+                precision = 9;
+            }
+            dot = 1;
+            while (len <= precision)
+            {
+                for (i = len; i > 0; i--)
+                {
+                    digits[i] = digits[i - 1];
+                }
+                digits[0] = '0';
+                len++;
+            }
+        }
+
+        i = len + dot + (sign ? 1 : 0);
+        pad = width > i ? width - i : 0;
+
+        if (!(field & (FIELD_LEFT | FIELD_ZERO)))
+        {
+            formatPad(sink, ' ', pad);
+        }
+        if (sign)
+        {
+            sink(sign);
+        }
+        if ((field & (FIELD_LEFT | FIELD_ZERO)) == FIELD_ZERO)
+        {
+            formatPad(sink, '0', pad);
+        }
+        for (i = 0; i < len; i++)
+        {
+            if (dot && i == len - precision)
+            {
+                sink('.');
+            }
+            sink(digits[i]);
+        }
+        if (field & FIELD_LEFT)
+        {
+            formatPad(sink, ' ', pad);
+        }
+    }
+}
+
+/*
+ *@fn        -   formatPrint
+ *
+ *@brief     -   Function to format a string into a sink, see at89s52_format.h for conversions
+ *
+ *@param[1]  -   Function that takes each output character
+ *@param[2]  -   Format string
+ *@param[3]  -   For multiple parameters
+ *
+ *return     -   void
+ */
+void formatPrint(formatSink_t sink, const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    formatPrintV(sink, fmt, args);
+    va_end(args);
+}
@@ -9,6 +9,58 @@
 // Library for function declarations
 #include "at89s52_gpio.h"
 
+#ifdef GPIO_USE_SHADOW
+
+/* Intended output latch of each port, starts at the reset value of the latches */
+__data uint8_t gpioShadowP0 = 0xFF;
+__data uint8_t gpioShadowP1 = 0xFF;
+__data uint8_t gpioShadowP2 = 0xFF;
+__data uint8_t gpioShadowP3 = 0xFF;
+
+/*
+ *@fn        -   gpioShadowOf
+ *
+ *@brief     -   Function to get the shadow byte of a port
+ *
+ *@param[1]  -   GPIO ports selection
+ *
+ *return     -   __data uint8_t *, 0 for an invalid port
+ */
+static __data uint8_t *gpioShadowOf(uint8_t port)
+{
+    switch (port)
+    {
+    case PORT0:
+        return &gpioShadowP0;
+    case PORT1:
+        return &gpioShadowP1;
+    case PORT2:
+        return &gpioShadowP2;
+    case PORT3:
+        return &gpioShadowP3;
+    default:
+        return 0; // Invalid port
+    }
+}
+
+#ifdef AT89S52_HOST
+/*
+ *@fn        -   gpioHostShadow
+ *
+ *@brief     -   Function to get the shadow byte of a port from its emulated register
+ *
+ *@param[1]  -   Emulated port register
+ *
+ *return     -   __data uint8_t *
+ */
+__data uint8_t *gpioHostShadow(volatile uint8_t *sfr)
+{
+    // P0, P1, P2 and P3 sit at 0x80, 0x90, 0xA0 and 0xB0
+    return gpioShadowOf((uint8_t)(((volatile hostSfr_t *)sfr - hostSfrFile) >> 4));
+}
+#endif
+
+#endif // GPIO_USE_SHADOW
 
 /*
  *@fn        -   gpioMode
@@ -23,6 +75,13 @@
  */
 void gpioPinMode(uint8_t port, uint8_t pinNum, uint8_t mode)
 {
+#ifdef GPIO_USE_SHADOW
+    // A 1 in the latch makes the quasi-bidirectional pin an input, a 0 drives it low
+    if (mode == OUTPUT || mode == INPUT)
+    {
+        gpioPinWrite(port, pinNum, mode);
+    }
+#else
     uint8_t mask = 1 << pinNum;
     if (mode == OUTPUT)
     {
@@ -60,6 +119,7 @@ void gpioPinMode(uint8_t port, uint8_t pinNum, uint8_t mode)
             break;
         }
     }
+#endif
 }
 
 /*
@@ -74,6 +134,12 @@ void gpioPinMode(uint8_t port, uint8_t pinNum, uint8_t mode)
  */
 void gpioPortMode(uint8_t port, uint8_t mode)
 {
+#ifdef GPIO_USE_SHADOW
+    if (mode == OUTPUT || mode == INPUT)
+    {
+        gpioPortWrite(port, (mode == INPUT) ? 0xFF : 0x00);
+    }
+#else
     uint8_t mask = 0xFF;
     if (mode == OUTPUT)
     {
@@ -111,6 +177,7 @@ void gpioPortMode(uint8_t port, uint8_t mode)
             break;
         }
     }
+#endif
 }
 
 /*
@@ -125,6 +192,16 @@ void gpioPortMode(uint8_t port, uint8_t mode)
  */
 void gpioPortWrite(uint8_t port, uint8_t value)
 {
+#ifdef GPIO_USE_SHADOW
+    __data uint8_t *shadow = gpioShadowOf(port);
+    uint8_t ea = EA;
+
+    EA = 0; // shadow and port change together, an ISR may write the same port
+    if (shadow)
+    {
+        *shadow = value;
+    }
+#endif
     switch (port)
     {
     case PORT0:
@@ -140,6 +217,9 @@ void gpioPortWrite(uint8_t port, uint8_t value)
         P3 = value;
         break;
     }
+#ifdef GPIO_USE_SHADOW
+    EA = ea;
+#endif
 }
 
 /*
@@ -155,6 +235,14 @@ void gpioPortWrite(uint8_t port, uint8_t value)
  */
 void gpioPinWrite(uint8_t port, uint8_t pinNum, uint8_t value)
 {
+#ifdef GPIO_USE_SHADOW
+    uint8_t ea = EA;
+
+    EA = 0;
+    gpioShadowPinWrite(port, pinNum, value);
+    gpioShadowCommit(port);
+    EA = ea;
+#else
     uint8_t mask = 1 << pinNum;
     switch (port)
     {
@@ -183,6 +271,70 @@ void gpioPinWrite(uint8_t port, uint8_t pinNum, uint8_t value)
             P3 &= ~mask;
         break;
     }
+#endif
+}
+
+/*
+ *@fn        -   gpioPortWriteMasked
+ *
+ *@brief     -   Function to write the masked pins of a port, the other pins keep their state
+ *
+ *@param[1]  -   GPIO ports selection
+ *@param[2]  -   Pins to change
+ *@param[3]  -   New state of those pins
+ *
+ *return     -   void
+ */
+void gpioPortWriteMasked(uint8_t port, uint8_t mask, uint8_t value)
+{
+    gpioPortSetClear(port, mask & value, mask & ~value);
+}
+
+/*
+ *@fn        -   gpioPortSetClear
+ *
+ *@brief     -   Function to set some pins and clear others of a port in one call
+ *
+ *@param[1]  -   GPIO ports selection
+ *@param[2]  -   Pins to set
+ *@param[3]  -   Pins to clear
+ *
+ *return     -   void
+ */
+void gpioPortSetClear(uint8_t port, uint8_t set, uint8_t clr)
+{
+#ifdef GPIO_USE_SHADOW
+    __data uint8_t *shadow = gpioShadowOf(port);
+    uint8_t ea = EA;
+
+    EA = 0; // no ISR may change the shadow between the read and the write
+    if (shadow)
+    {
+        gpioPortWrite(port, (*shadow & ~clr) | set);
+    }
+    EA = ea;
+#else
+    // ANL then ORL on the latch, each pin changes at most once
+    switch (port)
+    {
+    case PORT0:
+        P0 &= ~clr;
+        P0 |= set;
+        break;
+    case PORT1:
+        P1 &= ~clr;
+        P1 |= set;
+        break;
+    case PORT2:
+        P2 &= ~clr;
+        P2 |= set;
+        break;
+    case PORT3:
+        P3 &= ~clr;
+        P3 |= set;
+        break;
+    }
+#endif
 }
 
 /*
@@ -196,6 +348,17 @@ void gpioPinWrite(uint8_t port, uint8_t pinNum, uint8_t value)
  */
 void gpioPortToggle(uint8_t port)
 {
+#ifdef GPIO_USE_SHADOW
+    __data uint8_t *shadow = gpioShadowOf(port);
+    uint8_t ea = EA;
+
+    EA = 0; // no ISR may change the shadow between the read and the write
+    if (shadow)
+    {
+        gpioPortWrite(port, ~*shadow);
+    }
+    EA = ea;
+#else
     switch (port)
     {
     case PORT0:
@@ -214,6 +377,7 @@ void gpioPortToggle(uint8_t port)
         P3 = 0xFF;
         break;
     }
+#endif
 }
 
 /*
@@ -228,6 +392,17 @@ void gpioPortToggle(uint8_t port)
  */
 void gpioPinToggle(uint8_t port, uint8_t pinNum)
 {
+#ifdef GPIO_USE_SHADOW
+    __data uint8_t *shadow = gpioShadowOf(port);
+    uint8_t ea = EA;
+
+    EA = 0; // no ISR may change the shadow between the read and the write
+    if (shadow)
+    {
+        gpioPortWrite(port, *shadow ^ (1 << pinNum));
+    }
+    EA = ea;
+#else
     switch (port)
     {
     case PORT0:
@@ -246,6 +421,7 @@ void gpioPinToggle(uint8_t port, uint8_t pinNum)
         P3 ^= (1 << pinNum);
         break;
     }
+#endif
 }
 
 /*
@@ -302,6 +478,81 @@ uint8_t gpioPinRead(uint8_t port, uint8_t pinNum)
     }
 }
 
+#ifdef GPIO_USE_SHADOW
+/*
+ *@fn        -   gpioShadowPinWrite
+ *
+ *@brief     -   Function to change a pin in the port shadow only, the pin follows on commit
+ *
+ *@param[1]  -   GPIO ports selection
+ *@param[2]  -   Pin number of GPIO ports
+ *@param[3]  -   value to write
+ *
+ *return     -   void
+ */
+void gpioShadowPinWrite(uint8_t port, uint8_t pinNum, uint8_t value)
+{
+    __data uint8_t *shadow = gpioShadowOf(port);
+    uint8_t mask = 1 << pinNum;
+    uint8_t ea = EA;
+
+    if (!shadow)
+    {
+        return;
+    }
+    EA = 0; // the indirect read-modify-write takes three instructions
+    if (value)
+        *shadow |= mask; // Set bit
+    else
+        *shadow &= ~mask; // Clear bit
+    EA = ea;
+}
+
+/*
+ *@fn        -   gpioShadowCommit
+ *
+ *@brief     -   Function to store the port shadow to the port in one write
+ *
+ *@param[1]  -   GPIO ports selection
+ *
+ *return     -   void
+ */
+void gpioShadowCommit(uint8_t port)
+{
+    switch (port)
+    {
+    case PORT0:
+        GPIO_SHADOW_COMMIT(P0);
+        break;
+    case PORT1:
+        GPIO_SHADOW_COMMIT(P1);
+        break;
+    case PORT2:
+        GPIO_SHADOW_COMMIT(P2);
+        break;
+    case PORT3:
+        GPIO_SHADOW_COMMIT(P3);
+        break;
+    }
+}
+
+/*
+ *@fn        -   gpioShadowRead
+ *
+ *@brief     -   Function to read the intended output state of a port, not its pins
+ *
+ *@param[1]  -   GPIO ports selection
+ *
+ *return     -   uint8_t
+ */
+uint8_t gpioShadowRead(uint8_t port)
+{
+    __data uint8_t *shadow = gpioShadowOf(port);
+
+    return shadow ? *shadow : 0;
+}
+#endif // GPIO_USE_SHADOW
+
 /*
  *@fn        -   gpioInterruptConfig
  *
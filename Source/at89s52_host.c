@@ -0,0 +1,543 @@
+/*
+ * at89s52_host.c
+ * Description: Emulated SFR register file used when the drivers are built for the host with
+ *              gcc/clang and -DAT89S52_HOST. Models Timer 0/1/2, the external interrupt pins,
+ *              a byte level UART and the interrupt dispatcher, one machine cycle per SFR access.
+ *              Interrupt priorities (IP) are not modelled, an ISR is never interrupted.
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+#ifdef AT89S52_HOST
+
+// Library for SFR mnemonics, pulls in at89s52_host.h
+#include "at89s52.h"
+
+#define SFR(addr)           (hostSfrFile[(addr) - 0x80].byte)
+#define SFR_BIT(addr, n)    ((hostSfrFile[(addr) - 0x80].byte >> (n)) & 1)
+#define SFR_SET(addr, n)    (hostSfrFile[(addr) - 0x80].byte |= (uint8_t)(1 << (n)))
+#define SFR_CLR(addr, n)    (hostSfrFile[(addr) - 0x80].byte &= (uint8_t)~(1 << (n)))
+
+#define HOST_UART_QUEUE     256
+
+volatile hostSfr_t hostSfrFile[128];
+
+static volatile uint16_t sbufCell;
+static uint8_t rxLatch;
+
+static uint32_t cycleCount;
+static hostHook_t userHook;
+static hostHook_t isrTable[6];
+static uint8_t inIsr;
+
+static uint8_t lastInt0, lastInt1, lastT2ex;
+
+static uint32_t uartByteCycles = 1000;
+static uint32_t txCountdown, rxCountdown;
+static uint16_t txQueue[HOST_UART_QUEUE];
+static uint16_t rxQueue[HOST_UART_QUEUE];
+static uint16_t txHead, txTail, rxHead, rxTail;
+
+/*
+ *@fn        -   timer01Step
+ *
+ *@brief     -   Function to count Timer 0 or Timer 1 by one machine cycle
+ *
+ *@param[1]  -   TLx address
+ *@param[2]  -   THx address
+ *@param[3]  -   TMOD nibble of the timer
+ *@param[4]  -   TCON bit of the overflow flag
+ *
+ *return     -   void
+ */
+static void timer01Step(uint8_t tl, uint8_t th, uint8_t mode, uint8_t tfBit)
+{
+    if (mode & 0x04)
+    {
+        return; // Counter mode, no external pulses are modelled
+    }
+
+    switch (mode & 0x03)
+    {
+    case TIMER_MODE0: // 13 bit, TL uses 5 bits
+        SFR(tl) = (SFR(tl) + 1) & 0x1F;
+        if (SFR(tl) == 0)
+        {
+            SFR(th)++;
+            if (SFR(th) == 0)
+            {
+                SFR_SET(0x88, tfBit);
+            }
+        }
+        break;
+    case TIMER_MODE1: // 16 bit
+        SFR(tl)++;
+        if (SFR(tl) == 0)
+        {
+            SFR(th)++;
+            if (SFR(th) == 0)
+            {
+                SFR_SET(0x88, tfBit);
+            }
+        }
+        break;
+    case TIMER_MODE2: // 8 bit auto reload
+        SFR(tl)++;
+        if (SFR(tl) == 0)
+        {
+            SFR(tl) = SFR(th);
+            SFR_SET(0x88, tfBit);
+        }
+        break;
+    default: // Mode 3 is not modelled
+        break;
+    }
+}
+
+/*
+ *@fn        -   timer2Step
+ *
+ *@brief     -   Function to count Timer 2 by one machine cycle and handle T2EX events
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void timer2Step(void)
+{
+    uint8_t t2con = SFR(0xC8);
+    uint8_t baud = t2con & 0x30;
+    uint8_t t2ex = SFR_BIT(0x90, 1);
+    uint8_t n = baud ? 6 : 1; // Baud rate mode counts at fosc/2
+
+    if (lastT2ex && !t2ex && (t2con & 0x08))
+    {
+        if ((t2con & 0x01) && !baud)
+        {
+            SFR(0xCA) = SFR(0xCC); // Capture into RCAP2L/H
+            SFR(0xCB) = SFR(0xCD);
+        }
+        else if (!baud)
+        {
+            SFR(0xCC) = SFR(0xCA); // Reload from RCAP2L/H
+            SFR(0xCD) = SFR(0xCB);
+        }
+        SFR_SET(0xC8, 6); // EXF2
+    }
+    lastT2ex = t2ex;
+
+    if (!(t2con & 0x04) || (t2con & 0x02))
+    {
+        return; // Stopped or counter mode
+    }
+
+    while (n--)
+    {
+        uint16_t count = (uint16_t)((SFR(0xCD) << 8) | SFR(0xCC)) + 1;
+        if (count == 0)
+        {
+            if (baud || !(t2con & 0x01))
+            {
+                count = (uint16_t)((SFR(0xCB) << 8) | SFR(0xCA));
+            }
+            if (!baud)
+            {
+                SFR_SET(0xC8, 7); // TF2
+            }
+        }
+        SFR(0xCC) = count & 0xFF;
+        SFR(0xCD) = count >> 8;
+    }
+}
+
+/*
+ *@fn        -   externalStep
+ *
+ *@brief     -   Function to sample the INT0/INT1 pins and set IE0/IE1
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void externalStep(void)
+{
+    uint8_t int0 = SFR_BIT(0xB0, 2);
+    uint8_t int1 = SFR_BIT(0xB0, 3);
+
+    if (SFR_BIT(0x88, 0) ? (lastInt0 && !int0) : !int0)
+    {
+        SFR_SET(0x88, 1);
+    }
+    else if (!SFR_BIT(0x88, 0))
+    {
+        SFR_CLR(0x88, 1); // Level mode follows the pin
+    }
+    if (SFR_BIT(0x88, 2) ? (lastInt1 && !int1) : !int1)
+    {
+        SFR_SET(0x88, 3);
+    }
+    else if (!SFR_BIT(0x88, 2))
+    {
+        SFR_CLR(0x88, 3);
+    }
+
+    lastInt0 = int0;
+    lastInt1 = int1;
+}
+
+/*
+ *@fn        -   uartStep
+ *
+ *@brief     -   Function to run the fake UART for one machine cycle
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void uartStep(void)
+{
+    uint8_t scon = SFR(0x98);
+
+    if (!(sbufCell & HOST_SBUF_IDLE))
+    {
+        uint16_t data = sbufCell & 0xFF;
+        if ((scon & 0x80) && (scon & 0x08))
+        {
+            data |= 0x100; // TB8 in mode 2/3
+        }
+        if ((uint16_t)(txHead - txTail) < HOST_UART_QUEUE)
+        {
+            txQueue[txHead++ % HOST_UART_QUEUE] = data;
+        }
+        sbufCell = HOST_SBUF_IDLE | rxLatch;
+        txCountdown = uartByteCycles;
+    }
+
+    if (txCountdown && --txCountdown == 0)
+    {
+        SFR_SET(0x98, 1); // TI
+    }
+
+    if (!(scon & 0x10) || rxHead == rxTail)
+    {
+        return; // REN clear or nothing to receive
+    }
+
+    if (rxCountdown == 0)
+    {
+        rxCountdown = uartByteCycles;
+    }
+    else if (--rxCountdown == 0)
+    {
+        uint16_t data = rxQueue[rxTail++ % HOST_UART_QUEUE];
+        uint8_t rb8 = (data >> 8) & 1;
+
+        if (SFR_BIT(0x98, 0) || ((scon & 0x20) && !rb8))
+        {
+            return; // RI still set overruns, SM2 drops data bytes
+        }
+        rxLatch = data & 0xFF;
+        sbufCell = HOST_SBUF_IDLE | rxLatch;
+        if (rb8)
+        {
+            SFR_SET(0x98, 2);
+        }
+        else
+        {
+            SFR_CLR(0x98, 2);
+        }
+        SFR_SET(0x98, 0); // RI
+    }
+}
+
+/*
+ *@fn        -   dispatch
+ *
+ *@brief     -   Function to call the registered ISR of the first pending enabled interrupt
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void dispatch(void)
+{
+    uint8_t ie = SFR(0xA8);
+    uint8_t tcon = SFR(0x88);
+    int8_t vector = -1;
+
+    if (!(ie & 0x80) || inIsr)
+    {
+        return;
+    }
+
+    if ((ie & 0x01) && (tcon & 0x02))
+    {
+        vector = INT0_VECTOR;
+    }
+    else if ((ie & 0x02) && (tcon & 0x20))
+    {
+        vector = TIMER0_VECTOR;
+    }
+    else if ((ie & 0x04) && (tcon & 0x08))
+    {
+        vector = INT1_VECTOR;
+    }
+    else if ((ie & 0x08) && (tcon & 0x80))
+    {
+        vector = TIMER1_VECTOR;
+    }
+    else if ((ie & 0x10) && (SFR(0x98) & 0x03))
+    {
+        vector = SERIAL_VECTOR;
+    }
+    else if ((ie & 0x20) && (SFR(0xC8) & 0xC0))
+    {
+        vector = TIMER2_VECTOR;
+    }
+
+    if (vector < 0 || !isrTable[vector])
+    {
+        return;
+    }
+
+    // Hardware clears the timer 0/1 flags and the edge triggered IEx flags on vectoring
+    switch (vector)
+    {
+    case INT0_VECTOR:
+        if (tcon & 0x01)
+        {
+            SFR_CLR(0x88, 1);
+        }
+        break;
+    case TIMER0_VECTOR:
+        SFR_CLR(0x88, 5);
+        break;
+    case INT1_VECTOR:
+        if (tcon & 0x04)
+        {
+            SFR_CLR(0x88, 3);
+        }
+        break;
+    case TIMER1_VECTOR:
+        SFR_CLR(0x88, 7);
+        break;
+    }
+
+    inIsr = 1;
+    isrTable[vector]();
+    inIsr = 0;
+}
+
+/*
+ *@fn        -   stepOne
+ *
+ *@brief     -   Function to advance every emulated peripheral by one machine cycle
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void stepOne(void)
+{
+    uint8_t tmod = SFR(0x89);
+
+    cycleCount++;
+
+    if (SFR_BIT(0x88, 4))
+    {
+        timer01Step(0x8A, 0x8C, tmod & 0x0F, 5);
+    }
+    if (SFR_BIT(0x88, 6))
+    {
+        timer01Step(0x8B, 0x8D, tmod >> 4, 7);
+    }
+    timer2Step();
+    externalStep();
+    uartStep();
+
+    if (userHook)
+    {
+        userHook();
+    }
+
+    dispatch();
+}
+
+/*
+ *@fn        -   hostSfrAccess
+ *
+ *@brief     -   Function to advance the emulation one machine cycle and return the SFR cell
+ *
+ *@param[1]  -   SFR address, 0x80 to 0xFF
+ *
+ *return     -   volatile hostSfr_t *
+ */
+volatile hostSfr_t *hostSfrAccess(uint8_t addr)
+{
+    stepOne();
+    return &hostSfrFile[addr - 0x80];
+}
+
+/*
+ *@fn        -   hostSbufAccess
+ *
+ *@brief     -   Function to advance the emulation one machine cycle and return the SBUF cell
+ *
+ *@param[1]  -   void
+ *
+ *return     -   volatile uint16_t *
+ */
+volatile uint16_t *hostSbufAccess(void)
+{
+    stepOne();
+    return &sbufCell;
+}
+
+/*
+ *@fn        -   hostReset
+ *
+ *@brief     -   Function to load the reset values of every SFR and clear the emulator state
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+void hostReset(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < 128; i++)
+    {
+        hostSfrFile[i].byte = 0;
+    }
+    SFR(0x80) = 0xFF;
+    SFR(0x90) = 0xFF;
+    SFR(0xA0) = 0xFF;
+    SFR(0xB0) = 0xFF;
+    SFR(0x81) = 0x07;
+
+    rxLatch = 0;
+    sbufCell = HOST_SBUF_IDLE;
+    cycleCount = 0;
+    inIsr = 0;
+    lastInt0 = lastInt1 = lastT2ex = 1;
+    txCountdown = rxCountdown = 0;
+    txHead = txTail = rxHead = rxTail = 0;
+}
+
+/*
+ *@fn        -   hostStep
+ *
+ *@brief     -   Function to advance the emulation by a number of machine cycles
+ *
+ *@param[1]  -   Number of machine cycles
+ *
+ *return     -   void
+ */
+void hostStep(uint32_t cycles)
+{
+    while (cycles--)
+    {
+        stepOne();
+    }
+}
+
+/*
+ *@fn        -   hostCycles
+ *
+ *@brief     -   Function to get the machine cycles elapsed since hostReset
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint32_t
+ */
+uint32_t hostCycles(void)
+{
+    return cycleCount;
+}
+
+/*
+ *@fn        -   hostSetHook
+ *
+ *@brief     -   Function to install a callback run on every emulated machine cycle
+ *
+ *@param[1]  -   Hook function, 0 to remove
+ *
+ *return     -   void
+ */
+void hostSetHook(hostHook_t hook)
+{
+    userHook = hook;
+}
+
+/*
+ *@fn        -   hostAttachIsr
+ *
+ *@brief     -   Function to register the handler the dispatcher calls for an interrupt vector
+ *
+ *@param[1]  -   Vector number, INT0_VECTOR to TIMER2_VECTOR
+ *@param[2]  -   ISR function, 0 to remove
+ *
+ *return     -   void
+ */
+void hostAttachIsr(uint8_t vector, hostHook_t isr)
+{
+    if (vector <= TIMER2_VECTOR)
+    {
+        isrTable[vector] = isr;
+    }
+}
+
+/*
+ *@fn        -   hostUartSetByteCycles
+ *
+ *@brief     -   Function to set how many machine cycles the fake UART takes per byte
+ *
+ *@param[1]  -   Machine cycles per byte
+ *
+ *return     -   void
+ */
+void hostUartSetByteCycles(uint32_t cycles)
+{
+    uartByteCycles = cycles ? cycles : 1;
+}
+
+/*
+ *@fn        -   hostUartRxPush
+ *
+ *@brief     -   Function to queue a byte for the fake UART to receive, bit 8 goes to RB8
+ *
+ *@param[1]  -   Byte to receive
+ *
+ *return     -   uint8_t, 0 if the queue is full
+ */
+uint8_t hostUartRxPush(uint16_t data)
+{
+    if ((uint16_t)(rxHead - rxTail) >= HOST_UART_QUEUE)
+    {
+        return 0;
+    }
+    rxQueue[rxHead++ % HOST_UART_QUEUE] = data;
+    return 1;
+}
+
+/*
+ *@fn        -   hostUartTxPop
+ *
+ *@brief     -   Function to take the next byte the fake UART transmitted, bit 8 holds TB8
+ *
+ *@param[1]  -   void
+ *
+ *return     -   int, -1 if nothing was transmitted
+ */
+int hostUartTxPop(void)
+{
+    if (txHead == txTail)
+    {
+        return -1;
+    }
+    return txQueue[txTail++ % HOST_UART_QUEUE];
+}
+
+#endif // AT89S52_HOST
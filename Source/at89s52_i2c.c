@@ -0,0 +1,346 @@
+/*
+ * at89s52_i2c.c
+ * Description: This file contains the bit-banged I2C master. The half period delay is a
+ *              DJNZ count fixed at compile time from CLOCK_SOURCE and I2C_SPEED.
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for function declarations
+#include "at89s52_i2c.h"
+
+/* Machine cycles in half an SCL period */
+#define I2C_HALF_CYCLES     ((CLOCK_SOURCE / 12UL) / (2UL * I2C_SPEED))
+
+/* Machine cycles the pin handling already takes per half period */
+#ifndef I2C_BIT_OVERHEAD
+#define I2C_BIT_OVERHEAD 4
+#endif
+
+/* DJNZ iterations for the rest of the half period, 2 cycles each plus 1 for the load */
+#if I2C_HALF_CYCLES > I2C_BIT_OVERHEAD + 2
+#define I2C_DELAY_LOOPS     ((uint8_t)((I2C_HALF_CYCLES - I2C_BIT_OVERHEAD - 1) / 2))
+#define I2C_DELAY()         do { uint8_t n_ = I2C_DELAY_LOOPS; while (--n_) { IDLE_POLL(); } } while (0)
+#else
+#define I2C_DELAY()         IDLE_POLL()
+#endif
+
+/* Polls of SCL while a slave stretches the clock, about 8 machine cycles each */
+#define I2C_STRETCH_LOOPS   ((uint16_t)((I2C_TIMEOUT_US * (CLOCK_SOURCE / 12000UL)) / 8000UL + 1))
+
+/* Read and write bits of the address byte */
+#define I2C_WRITE   0x00
+#define I2C_READ    0x01
+
+/*
+ *@fn        -   i2cSclRelease
+ *
+ *@brief     -   Function to let SCL go high and wait while a slave stretches the clock
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t, 0 on timeout
+ */
+static uint8_t i2cSclRelease(void)
+{
+    uint16_t n = I2C_STRETCH_LOOPS;
+
+    GPIO_PIN_SET(I2C_SCL);
+    while (!GPIO_PIN_READ(I2C_SCL))
+    {
+        if (--n == 0)
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/*
+ *@fn        -   i2cStart
+ *
+ *@brief     -   Function to send a start, or a repeated start when SCL is low
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t, I2C_OK or I2C_TIMEOUT
+ */
+static uint8_t i2cStart(void)
+{
+    GPIO_PIN_SET(I2C_SDA);
+    I2C_DELAY();
+    if (!i2cSclRelease())
+    {
+        return I2C_TIMEOUT;
+    }
+    I2C_DELAY();
+    GPIO_PIN_CLEAR(I2C_SDA); // SDA falls while SCL is high
+    I2C_DELAY();
+    GPIO_PIN_CLEAR(I2C_SCL);
+
+    return I2C_OK;
+}
+
+/*
+ *@fn        -   i2cStop
+ *
+ *@brief     -   Function to send a stop and leave both lines released
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void i2cStop(void)
+{
+    GPIO_PIN_CLEAR(I2C_SDA);
+    I2C_DELAY();
+    i2cSclRelease(); // a timeout here leaves nothing more to do
+    I2C_DELAY();
+    GPIO_PIN_SET(I2C_SDA); // SDA rises while SCL is high
+    I2C_DELAY();
+}
+
+/*
+ *@fn        -   i2cTxByte
+ *
+ *@brief     -   Function to clock out one byte MSB first and read the acknowledge
+ *
+ *@param[1]  -   Byte to send
+ *
+ *return     -   uint8_t, I2C_OK, I2C_NACK or I2C_TIMEOUT
+ */
+static uint8_t i2cTxByte(uint8_t b)
+{
+    uint8_t i;
+    uint8_t nack;
+
+    for (i = 0; i < 8; i++)
+    {
+        GPIO_PIN_WRITE(I2C_SDA, b & 0x80);
+        b <<= 1;
+        I2C_DELAY();
+        if (!i2cSclRelease())
+        {
+            return I2C_TIMEOUT;
+        }
+        I2C_DELAY();
+        GPIO_PIN_CLEAR(I2C_SCL);
+    }
+
+    // Ninth clock, the slave pulls SDA low to acknowledge
+    GPIO_PIN_SET(I2C_SDA);
+    I2C_DELAY();
+    if (!i2cSclRelease())
+    {
+        return I2C_TIMEOUT;
+    }
+    nack = GPIO_PIN_READ(I2C_SDA);
+    I2C_DELAY();
+    GPIO_PIN_CLEAR(I2C_SCL);
+
+    return nack ? I2C_NACK : I2C_OK;
+}
+
+/*
+ *@fn        -   i2cRxByte
+ *
+ *@brief     -   Function to clock in one byte MSB first and send the acknowledge
+ *
+ *@param[1]  -   Reference to store the byte
+ *@param[2]  -   1 to acknowledge, 0 after the last byte of a read
+ *
+ *return     -   uint8_t, I2C_OK or I2C_TIMEOUT
+ */
+static uint8_t i2cRxByte(uint8_t *buf, uint8_t ack)
+{
+    uint8_t i;
+    uint8_t b = 0;
+
+    GPIO_PIN_SET(I2C_SDA); // release, the slave drives the data
+    for (i = 0; i < 8; i++)
+    {
+        I2C_DELAY();
+        if (!i2cSclRelease())
+        {
+            return I2C_TIMEOUT;
+        }
+        b = (b << 1) | GPIO_PIN_READ(I2C_SDA);
+        I2C_DELAY();
+        GPIO_PIN_CLEAR(I2C_SCL);
+    }
+    *buf = b;
+
+    GPIO_PIN_WRITE(I2C_SDA, !ack);
+    I2C_DELAY();
+    if (!i2cSclRelease())
+    {
+        return I2C_TIMEOUT;
+    }
+    I2C_DELAY();
+    GPIO_PIN_CLEAR(I2C_SCL);
+    GPIO_PIN_SET(I2C_SDA);
+
+    return I2C_OK;
+}
+
+/*
+ *@fn        -   i2cTxBurst
+ *
+ *@brief     -   Function to send the address byte for a write and the data that follows
+ *
+ *@param[1]  -   7 bit slave address
+ *@param[2]  -   Data reference
+ *@param[3]  -   Number of bytes
+ *
+ *return     -   uint8_t, I2C_OK, I2C_NACK or I2C_TIMEOUT
+ */
+static uint8_t i2cTxBurst(uint8_t address, const uint8_t *buf, uint8_t len)
+{
+    uint8_t status = i2cTxByte((address << 1) | I2C_WRITE);
+
+    while (status == I2C_OK && len--)
+    {
+        status = i2cTxByte(*buf++);
+    }
+
+    return status;
+}
+
+/*
+ *@fn        -   i2cRxBurst
+ *
+ *@brief     -   Function to send the address byte for a read and read the data that follows
+ *
+ *@param[1]  -   7 bit slave address
+ *@param[2]  -   Buffer reference
+ *@param[3]  -   Number of bytes, at least 1
+ *
+ *return     -   uint8_t, I2C_OK, I2C_NACK or I2C_TIMEOUT
+ */
+static uint8_t i2cRxBurst(uint8_t address, uint8_t *buf, uint8_t len)
+{
+    uint8_t status = i2cTxByte((address << 1) | I2C_READ);
+
+    while (status == I2C_OK && len)
+    {
+        len--;
+        status = i2cRxByte(buf++, len != 0);
+    }
+
+    return status;
+}
+
+/*
+ *@fn        -   i2cInit
+ *
+ *@brief     -   Function to release the bus, clocks out a slave left holding SDA low
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+void i2cInit(void)
+{
+    uint8_t i;
+
+    GPIO_PIN_SET(I2C_SDA);
+    GPIO_PIN_SET(I2C_SCL);
+
+    // A slave stopped in the middle of a byte lets go of SDA after at most 9 clocks
+    for (i = 0; i < 9 && !GPIO_PIN_READ(I2C_SDA); i++)
+    {
+        GPIO_PIN_CLEAR(I2C_SCL);
+        I2C_DELAY();
+        if (!i2cSclRelease())
+        {
+            break;
+        }
+        I2C_DELAY();
+    }
+
+    i2cStop();
+}
+
+/*
+ *@fn        -   i2cWrite
+ *
+ *@brief     -   Function to write a burst of bytes to a slave
+ *
+ *@param[1]  -   7 bit slave address
+ *@param[2]  -   Data reference
+ *@param[3]  -   Number of bytes
+ *
+ *return     -   uint8_t, I2C_OK, I2C_NACK or I2C_TIMEOUT
+ */
+uint8_t i2cWrite(uint8_t address, const uint8_t *buf, uint8_t len)
+{
+    uint8_t status = i2cStart();
+
+    if (status == I2C_OK)
+    {
+        status = i2cTxBurst(address, buf, len);
+    }
+    i2cStop();
+
+    return status;
+}
+
+/*
+ *@fn        -   i2cRead
+ *
+ *@brief     -   Function to read a burst of bytes from a slave
+ *
+ *@param[1]  -   7 bit slave address
+ *@param[2]  -   Buffer reference
+ *@param[3]  -   Number of bytes, at least 1
+ *
+ *return     -   uint8_t, I2C_OK, I2C_NACK or I2C_TIMEOUT
+ */
+uint8_t i2cRead(uint8_t address, uint8_t *buf, uint8_t len)
+{
+    uint8_t status = i2cStart();
+
+    if (status == I2C_OK)
+    {
+        status = i2cRxBurst(address, buf, len);
+    }
+    i2cStop();
+
+    return status;
+}
+
+/*
+ *@fn        -   i2cWriteRead
+ *
+ *@brief     -   Function to write then read in one transaction with a repeated start
+ *
+ *@param[1]  -   7 bit slave address
+ *@param[2]  -   Data to write
+ *@param[3]  -   Number of bytes to write
+ *@param[4]  -   Buffer for the read
+ *@param[5]  -   Number of bytes to read, at least 1
+ *
+ *return     -   uint8_t, I2C_OK, I2C_NACK or I2C_TIMEOUT
+ */
+uint8_t i2cWriteRead(uint8_t address, const uint8_t *tx, uint8_t txLen, uint8_t *rx, uint8_t rxLen)
+{
+    uint8_t status = i2cStart();
+
+    if (status == I2C_OK)
+    {
+        status = i2cTxBurst(address, tx, txLen);
+    }
+    if (status == I2C_OK)
+    {
+        status = i2cStart(); // repeated start, the bus is not released in between
+    }
+    if (status == I2C_OK)
+    {
+        status = i2cRxBurst(address, rx, rxLen);
+    }
+    i2cStop();
+
+    return status;
+}
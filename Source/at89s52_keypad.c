@@ -0,0 +1,260 @@
+/*
+ * at89s52_keypad.c
+ * Description: This file contains the matrix keypad scanner. The tick drives one row low and
+ *              reads the columns per tick, full scans are compared, checked for ghosting and
+ *              turned into press/release events in a FIFO.
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for function declarations
+#include "at89s52_keypad.h"
+// Library for the constant port writes
+#include "at89s52_gpio.h"
+
+#define KEYPAD_ROW_MASK     ((uint8_t)(((1U << KEYPAD_ROWS) - 1) << KEYPAD_ROW_SHIFT))
+#define KEYPAD_COL_MASK     ((uint8_t)(((1U << KEYPAD_COLS) - 1) << KEYPAD_COL_SHIFT))
+#define KEYPAD_FIRST_ROW    ((uint8_t)(1U << KEYPAD_ROW_SHIFT))
+#define KEYPAD_FIFO_MASK    (KEYPAD_FIFO_SIZE - 1)
+
+/* Compile time checks, the matrix must fit its ports and the FIFO indexes are free running uint8_t */
+typedef char keypadRowCheck[(KEYPAD_ROWS >= 1 && KEYPAD_ROWS + KEYPAD_ROW_SHIFT <= 8) ? 1 : -1];
+typedef char keypadColCheck[(KEYPAD_COLS >= 1 && KEYPAD_COLS + KEYPAD_COL_SHIFT <= 8) ? 1 : -1];
+typedef char keypadFifoCheck[((KEYPAD_FIFO_SIZE & KEYPAD_FIFO_MASK) == 0 && KEYPAD_FIFO_SIZE <= 128) ? 1 : -1];
+
+/* One more expansion so the port macros become port names before the GPIO macros paste them */
+#define KEYPAD_WRITE_MASKED(port, mask, value)  GPIO_PORT_WRITE_MASKED(port, mask, value)
+#define KEYPAD_SET_CLEAR(port, set, clr)        GPIO_PORT_SET_CLEAR(port, set, clr)
+
+static uint8_t scan[KEYPAD_ROWS];   // columns read in the scan in progress
+static uint8_t last[KEYPAD_ROWS];   // previous complete scan
+static uint8_t keys[KEYPAD_ROWS];   // accepted state, 1 = held
+static uint8_t row;
+static uint8_t rowBit;
+static __bit ghosted;
+
+static uint8_t fifo[KEYPAD_FIFO_SIZE];
+static volatile uint8_t head, tail;
+static volatile uint8_t overflows;
+
+/*
+ *@fn        -   keypadPush
+ *
+ *@brief     -   Function to queue a key event, counts it as lost when the FIFO is full
+ *
+ *@param[1]  -   Event byte
+ *
+ *return     -   void
+ */
+static void keypadPush(uint8_t event)
+{
+    if ((uint8_t)(head - tail) == KEYPAD_FIFO_SIZE)
+    {
+        overflows++;
+        return;
+    }
+    fifo[head & KEYPAD_FIFO_MASK] = event;
+    head++;
+}
+
+/*
+ *@fn        -   keypadScanDone
+ *
+ *@brief     -   Function to accept a complete scan and queue the key changes
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void keypadScanDone(void)
+{
+    uint8_t r;
+    uint8_t c;
+    uint8_t colBit;
+    uint8_t diff;
+    __bit stable = 1;
+
+    // Debounce, the matrix must read the same in two scans in a row
+    for (r = 0; r < KEYPAD_ROWS; r++)
+    {
+        if (scan[r] != last[r])
+        {
+            stable = 0;
+        }
+        last[r] = scan[r];
+    }
+    if (!stable)
+    {
+        return;
+    }
+
+#ifndef KEYPAD_DIODES
+    // Two rows sharing two or more columns form a rectangle, one of its corners may be a ghost
+    for (r = 0; r < KEYPAD_ROWS - 1; r++)
+    {
+        for (c = r + 1; c < KEYPAD_ROWS; c++)
+        {
+            diff = last[r] & last[c];
+            if (diff & (diff - 1))
+            {
+                ghosted = 1;
+                return;
+            }
+        }
+    }
+    ghosted = 0;
+#endif
+
+    // Every key is tracked on its own, any number may be held at once
+    for (r = 0; r < KEYPAD_ROWS; r++)
+    {
+        diff = last[r] ^ keys[r];
+        if (!diff)
+        {
+            continue;
+        }
+        for (c = 0, colBit = 1; c < KEYPAD_COLS; c++, colBit <<= 1)
+        {
+            if (diff & colBit)
+            {
+                keypadPush(((last[r] & colBit) ? 0 : KEYPAD_RELEASED) | (r << 3) | c);
+            }
+        }
+        keys[r] = last[r];
+    }
+}
+
+/*
+ *@fn        -   keypadTick
+ *
+ *@brief     -   Tick hook, reads the row driven since the last tick and drives the next one
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void keypadTick(void)
+{
+    // The row had a whole tick to settle, pressed keys pull their column low
+    scan[row] = ((uint8_t)~KEYPAD_COL_PORT & KEYPAD_COL_MASK) >> KEYPAD_COL_SHIFT;
+
+    row++;
+    rowBit <<= 1;
+    if (row == KEYPAD_ROWS)
+    {
+        row = 0;
+        rowBit = KEYPAD_FIRST_ROW;
+        keypadScanDone();
+    }
+
+    KEYPAD_WRITE_MASKED(KEYPAD_ROW_PORT, KEYPAD_ROW_MASK, ~rowBit);
+}
+
+/*
+ *@fn        -   keypadInit
+ *
+ *@brief     -   Function to set up the matrix pins and attach the scan to the tick
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t, 0 if the tick has no free hook
+ */
+uint8_t keypadInit(void)
+{
+    uint8_t r;
+
+    for (r = 0; r < KEYPAD_ROWS; r++)
+    {
+        scan[r] = 0;
+        last[r] = 0;
+        keys[r] = 0;
+    }
+    head = tail = 0;
+    overflows = 0;
+    ghosted = 0;
+    row = 0;
+    rowBit = KEYPAD_FIRST_ROW;
+
+    // Columns are inputs, the first row is driven low for the first tick
+    KEYPAD_SET_CLEAR(KEYPAD_COL_PORT, KEYPAD_COL_MASK, 0);
+    KEYPAD_WRITE_MASKED(KEYPAD_ROW_PORT, KEYPAD_ROW_MASK, ~rowBit);
+
+    return tickAttach(keypadTick);
+}
+
+/*
+ *@fn        -   keypadRead
+ *
+ *@brief     -   Function to take the oldest key event, never blocks
+ *
+ *@param[1]  -   Reference to store the event byte
+ *
+ *return     -   uint8_t, 1 if an event was read else 0
+ */
+uint8_t keypadRead(uint8_t *event)
+{
+    if (head == tail)
+    {
+        return 0;
+    }
+    *event = fifo[tail & KEYPAD_FIFO_MASK];
+    tail++;
+    return 1;
+}
+
+/*
+ *@fn        -   keypadAvailable
+ *
+ *@brief     -   Function to get the number of key events waiting
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t
+ */
+uint8_t keypadAvailable(void)
+{
+    return (uint8_t)(head - tail);
+}
+
+/*
+ *@fn        -   keypadRow
+ *
+ *@brief     -   Function to get the keys held in a row
+ *
+ *@param[1]  -   Row number
+ *
+ *return     -   uint8_t, column mask
+ */
+uint8_t keypadRow(uint8_t r)
+{
+    return (r < KEYPAD_ROWS) ? keys[r] : 0;
+}
+
+/*
+ *@fn        -   keypadGhosted
+ *
+ *@brief     -   Function to check whether the last scan was ambiguous
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t
+ */
+uint8_t keypadGhosted(void)
+{
+    return ghosted;
+}
+
+/*
+ *@fn        -   keypadOverflows
+ *
+ *@brief     -   Function to get the number of key events lost because the FIFO was full
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t
+ */
+uint8_t keypadOverflows(void)
+{
+    return overflows;
+}
@@ -0,0 +1,440 @@
+/*
+ * at89s52_lcd.c
+ * Description: This file contains the HD44780 character LCD driver. Drawing only changes a RAM
+ *              framebuffer and marks the cells that differ, lcdRefresh() sends them one at a
+ *              time from the main loop so nothing waits on the controller.
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for function declarations
+#include "at89s52_lcd.h"
+
+// Library for the delays of the power-on sequence
+#include "at89s52_timer.h"
+
+// Library for the tick counter that paces the refresh without R/W
+#include "at89s52_tick.h"
+
+// Library for the formatted output engine behind lcdPrint
+#include "at89s52_format.h"
+
+/* Standard library for variable arguments */
+#include <stdarg.h>
+
+/* Commands */
+#define LCD_CLEAR           0x01
+#define LCD_ENTRY_INC       0x06    // entry mode, address counter increments, no shift
+#define LCD_DISPLAY_OFF     0x08
+#define LCD_DISPLAY_ON      0x0C    // display on, cursor and blink off
+#define LCD_FUNCTION_SET    0x20
+#define LCD_8BIT            0x10
+#define LCD_2LINE           0x08
+#define LCD_SET_DDRAM       0x80
+
+/* Execution time of most commands and of a clear, in microseconds */
+#define LCD_CMD_US          50
+#define LCD_CLEAR_US        2000
+
+/* Data bus bits and the busy flag on the port */
+#ifdef LCD_4BIT
+#define LCD_NIBBLE_MASK     ((uint8_t)(0x0F << LCD_NIBBLE_SHIFT))
+#define LCD_BUSY_BIT        ((uint8_t)(0x08 << LCD_NIBBLE_SHIFT))
+#else
+#define LCD_BUSY_BIT        0x80
+#endif
+
+typedef char lcdSizeCheck[(LCD_ROWS >= 1 && LCD_ROWS <= 4 && LCD_COLS >= 1 && LCD_COLS <= 20) ? 1 : -1];
+
+static LCD_BUFFER_SPACE uint8_t frame[LCD_CELLS];
+static LCD_BUFFER_SPACE uint8_t dirty[(LCD_CELLS + 7) / 8];
+static uint8_t dirtyCount;
+static uint8_t drawPos;     // cell lcdPutc writes next
+static uint8_t scanPos;     // cell lcdRefresh looks at next
+static uint8_t lcdAddress;  // DDRAM address counter of the controller
+#ifdef LCD_NO_RW
+static uint8_t lastTick;
+#endif
+
+/*
+ *@fn        -   lcdPulse
+ *
+ *@brief     -   Function to latch the bus into the controller on the falling edge of EN
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void lcdPulse(void)
+{
+    GPIO_PIN_SET(LCD_EN);
+    GPIO_PIN_CLEAR(LCD_EN);
+}
+
+#ifdef LCD_4BIT
+/*
+ *@fn        -   lcdNibble
+ *
+ *@brief     -   Function to send four bits on D4-D7
+ *
+ *@param[1]  -   Nibble, low four bits
+ *
+ *return     -   void
+ */
+static void lcdNibble(uint8_t nibble)
+{
+    gpioPortWriteMasked(LCD_DATA_PORT, LCD_NIBBLE_MASK, nibble << LCD_NIBBLE_SHIFT);
+    lcdPulse();
+}
+#endif
+
+/*
+ *@fn        -   lcdWrite
+ *
+ *@brief     -   Function to send one byte to the instruction or the data register
+ *
+ *@param[1]  -   0 for a command, 1 for a character
+ *@param[2]  -   Byte to send
+ *
+ *return     -   void
+ */
+static void lcdWrite(uint8_t rs, uint8_t value)
+{
+    GPIO_PIN_WRITE(LCD_RS, rs);
+#ifdef LCD_4BIT
+    lcdNibble(value >> 4);
+    lcdNibble(value & 0x0F);
+#else
+    gpioPortWrite(LCD_DATA_PORT, value);
+    lcdPulse();
+#endif
+}
+
+/*
+ *@fn        -   lcdCommand
+ *
+ *@brief     -   Function to send a command and wait it out, only used while setting up
+ *
+ *@param[1]  -   Command
+ *
+ *return     -   void
+ */
+static void lcdCommand(uint8_t cmd)
+{
+    lcdWrite(0, cmd);
+    delay_us(cmd == LCD_CLEAR ? LCD_CLEAR_US : LCD_CMD_US);
+}
+
+/*
+ *@fn        -   lcdReady
+ *
+ *@brief     -   Function to check whether the controller takes the next byte, from the busy
+ *               flag or, without R/W, once per tick
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t, 1 if ready
+ */
+static uint8_t lcdReady(void)
+{
+#ifdef LCD_NO_RW
+    uint8_t now = (uint8_t)tickCount; // the low byte is enough to see it move
+
+    if (now == lastTick)
+    {
+        return 0;
+    }
+    lastTick = now;
+    return 1;
+#else
+    uint8_t busy;
+
+    // Release the bus to the controller before it drives it
+    GPIO_PIN_CLEAR(LCD_RS);
+#ifdef LCD_4BIT
+    gpioPortWriteMasked(LCD_DATA_PORT, LCD_NIBBLE_MASK, LCD_NIBBLE_MASK);
+#else
+    gpioPortWrite(LCD_DATA_PORT, 0xFF);
+#endif
+    GPIO_PIN_SET(LCD_RW);
+    GPIO_PIN_SET(LCD_EN);
+    busy = gpioPortRead(LCD_DATA_PORT) & LCD_BUSY_BIT;
+    GPIO_PIN_CLEAR(LCD_EN);
+#ifdef LCD_4BIT
+    lcdPulse(); // second half of the status byte, the address counter is not needed
+#endif
+    GPIO_PIN_CLEAR(LCD_RW);
+
+    return !busy;
+#endif
+}
+
+/*
+ *@fn        -   lcdCellAddress
+ *
+ *@brief     -   Function to map a framebuffer cell to its DDRAM address. Rows 2 and 3
+ *               continue rows 0 and 1 in DDRAM
+ *
+ *@param[1]  -   Cell, row * LCD_COLS + column
+ *
+ *return     -   uint8_t
+ */
+static uint8_t lcdCellAddress(uint8_t cell)
+{
+    uint8_t address = 0;
+
+    if (cell >= 2 * LCD_COLS)
+    {
+        cell -= 2 * LCD_COLS;
+        address = LCD_COLS;
+    }
+    if (cell >= LCD_COLS)
+    {
+        cell -= LCD_COLS;
+        address += 0x40;
+    }
+
+    return address + cell;
+}
+
+/*
+ *@fn        -   lcdInit
+ *
+ *@brief     -   Function to reset and set up the controller
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+void lcdInit(void)
+{
+    uint8_t i;
+
+    GPIO_PIN_CLEAR(LCD_EN);
+    GPIO_PIN_CLEAR(LCD_RS);
+#ifndef LCD_NO_RW
+    GPIO_PIN_CLEAR(LCD_RW);
+#endif
+    delay_ms(40);
+
+    // Reset by instruction, the controller may be in either bus width after a brown-out
+#ifdef LCD_4BIT
+    lcdNibble(0x03);
+    delay_ms(5);
+    lcdNibble(0x03);
+    delay_us(150);
+    lcdNibble(0x03);
+    delay_us(150);
+    lcdNibble(0x02);
+    delay_us(LCD_CMD_US);
+    lcdCommand(LCD_FUNCTION_SET | (LCD_ROWS > 1 ? LCD_2LINE : 0));
+#else
+    lcdWrite(0, LCD_FUNCTION_SET | LCD_8BIT);
+    delay_ms(5);
+    lcdWrite(0, LCD_FUNCTION_SET | LCD_8BIT);
+    delay_us(150);
+    lcdCommand(LCD_FUNCTION_SET | LCD_8BIT);
+    lcdCommand(LCD_FUNCTION_SET | LCD_8BIT | (LCD_ROWS > 1 ? LCD_2LINE : 0));
+#endif
+    lcdCommand(LCD_DISPLAY_OFF);
+    lcdCommand(LCD_CLEAR);
+    lcdCommand(LCD_ENTRY_INC);
+    lcdCommand(LCD_DISPLAY_ON);
+
+    // The display is blank now, so is the framebuffer
+    for (i = 0; i < LCD_CELLS; i++)
+    {
+        frame[i] = ' ';
+    }
+    for (i = 0; i < sizeof(dirty); i++)
+    {
+        dirty[i] = 0;
+    }
+    dirtyCount = 0;
+    drawPos = 0;
+    scanPos = 0;
+    lcdAddress = 0;
+#ifdef LCD_NO_RW
+    lastTick = (uint8_t)tickCount;
+#endif
+}
+
+/*
+ *@fn        -   lcdSetCursor
+ *
+ *@brief     -   Function to move the drawing position in the framebuffer
+ *
+ *@param[1]  -   Column, 0 to LCD_COLS - 1
+ *@param[2]  -   Row, 0 to LCD_ROWS - 1
+ *
+ *return     -   void
+ */
+void lcdSetCursor(uint8_t col, uint8_t row)
+{
+    if (col < LCD_COLS && row < LCD_ROWS)
+    {
+        drawPos = row * LCD_COLS + col;
+    }
+}
+
+/*
+ *@fn        -   lcdPutc
+ *
+ *@brief     -   Function to draw one character at the drawing position and advance it
+ *
+ *@param[1]  -   Character, '\n' moves to the start of the next row
+ *
+ *return     -   void
+ */
+void lcdPutc(uint8_t c)
+{
+    uint8_t mask;
+    uint8_t rowEnd;
+
+    if (c == '\n')
+    {
+        for (rowEnd = LCD_COLS; rowEnd <= drawPos; rowEnd += LCD_COLS);
+        drawPos = (rowEnd == LCD_CELLS) ? 0 : rowEnd;
+        return;
+    }
+
+    if (frame[drawPos] != c)
+    {
+        frame[drawPos] = c;
+        mask = 1 << (drawPos & 7);
+        if (!(dirty[drawPos >> 3] & mask))
+        {
+            dirty[drawPos >> 3] |= mask;
+            dirtyCount++;
+        }
+    }
+
+    if (++drawPos == LCD_CELLS)
+    {
+        drawPos = 0;
+    }
+}
+
+/*
+ *@fn        -   lcdPuts
+ *
+ *@brief     -   Function to draw a string at the drawing position
+ *
+ *@param[1]  -   String reference
+ *
+ *return     -   void
+ */
+void lcdPuts(const char *s)
+{
+    while (*s)
+    {
+        lcdPutc(*s++);
+    }
+}
+
+/*
+ *@fn        -   lcdPrint
+ *
+ *@brief     -   Function to draw formatted text at the drawing position
+ *
+ *@param[1]  -   Format string
+ *@param[2]  -   Arguments
+ *
+ *return     -   void
+ */
+void lcdPrint(const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    formatPrintV(lcdPutc, fmt, args);
+    va_end(args);
+}
+
+/*
+ *@fn        -   lcdClear
+ *
+ *@brief     -   Function to blank the framebuffer and move the drawing position home. Only
+ *               cells that were not blank are sent, the slow clear command is not used
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+void lcdClear(void)
+{
+    uint8_t i;
+
+    drawPos = 0;
+    for (i = 0; i < LCD_CELLS; i++)
+    {
+        lcdPutc(' ');
+    }
+}
+
+/*
+ *@fn        -   lcdRefresh
+ *
+ *@brief     -   Function to send at most one changed character or address command. A run of
+ *               changed cells costs one address command and then one byte per cell
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+void lcdRefresh(void)
+{
+    uint8_t bits;
+    uint8_t address;
+
+    if (!dirtyCount || !lcdReady())
+    {
+        return;
+    }
+
+    // Next changed cell from where the last refresh stopped, whole clean bytes are skipped
+    for (;;)
+    {
+        bits = dirty[scanPos >> 3] >> (scanPos & 7);
+        if (bits & 0x01)
+        {
+            break;
+        }
+        scanPos = bits ? scanPos + 1 : (scanPos | 7) + 1;
+        if (scanPos >= LCD_CELLS)
+        {
+            scanPos = 0;
+        }
+    }
+
+    address = lcdCellAddress(scanPos);
+    if (address != lcdAddress)
+    {
+        lcdWrite(0, LCD_SET_DDRAM | address);
+        lcdAddress = address;
+        return;
+    }
+
+    lcdWrite(1, frame[scanPos]);
+    lcdAddress++;
+    dirty[scanPos >> 3] &= ~(1 << (scanPos & 7));
+    dirtyCount--;
+    if (++scanPos == LCD_CELLS)
+    {
+        scanPos = 0;
+    }
+}
+
+/*
+ *@fn        -   lcdPending
+ *
+ *@brief     -   Function to get the number of cells still waiting for lcdRefresh()
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t
+ */
+uint8_t lcdPending(void)
+{
+    return dirtyCount;
+}
@@ -0,0 +1,76 @@
+/*
+ * at89s52_log.c
+ * Description: This file contains the deferred binary log. Call sites send a format id, a
+ *              timestamp and the raw argument bytes, the text is rebuilt on the host by
+ *              Tools/logdecode.c from the same format table.
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for function declarations
+#include "at89s52_log.h"
+// Library for the UART the records drain through
+#include "at89s52_serial.h"
+// Library for the record timestamps
+#include "at89s52_tick.h"
+
+static uint16_t dropped;
+
+/*
+ *@fn        -   logRecord
+ *
+ *@brief     -   Function to queue one binary log record for the UART
+ *
+ *@param[1]  -   Format id LOG_<name>
+ *@param[2]  -   Raw argument bytes, laid out as the format expects
+ *@param[3]  -   Number of argument bytes, at most LOG_MAX_ARGS
+ *
+ *return     -   void
+ */
+void logRecord(uint8_t id, const void *args, uint8_t len)
+{
+    const uint8_t *p = (const uint8_t *)args;
+    uint16_t stamp;
+
+    if (len > LOG_MAX_ARGS)
+    {
+        dropped++;
+        return;
+    }
+
+#ifdef SERIAL_USE_INTERRUPT
+    // Whole records only, a partial one would cost the decoder a resync
+    if (serialTxAvailable() < (uint8_t)(LOG_HEADER_SIZE + len))
+    {
+        dropped++;
+        return;
+    }
+#endif
+
+    stamp = (uint16_t)millis();
+
+    serialTx(LOG_SYNC);
+    serialTx(id);
+    serialTx(len);
+    serialTx(stamp & 0xFF);
+    serialTx(stamp >> 8);
+    while (len--)
+    {
+        serialTx(*p++);
+    }
+}
+
+/*
+ *@fn        -   logDropped
+ *
+ *@brief     -   Function to get the number of records dropped because the TX buffer was full
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint16_t
+ */
+uint16_t logDropped(void)
+{
+    return dropped;
+}
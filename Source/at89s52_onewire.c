@@ -0,0 +1,339 @@
+/*
+ * at89s52_onewire.c
+ * Description: This file contains the 1-Wire bus driver. Slots are timed by counting
+ *              DJNZ iterations fixed at compile time from CLOCK_SOURCE, delay_us() only
+ *              times the reset pulse where a few microseconds do not matter.
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for function declarations
+#include "at89s52_onewire.h"
+
+// Library for delay_us
+#include "at89s52_timer.h"
+
+/* Standard speed slot timing in microseconds */
+#define ONEWIRE_T_LOW1      6   // write 1 and read, line low
+#define ONEWIRE_T_HIGH1     64  // write 1, rest of the slot
+#define ONEWIRE_T_LOW0      60  // write 0, line low
+#define ONEWIRE_T_HIGH0     10  // write 0, recovery
+#define ONEWIRE_T_SAMPLE    9   // read, release to sample
+#define ONEWIRE_T_READ_END  55  // read, sample to end of the slot
+#define ONEWIRE_T_RESET     480 // reset pulse
+#define ONEWIRE_T_PRESENCE  70  // release to presence sample
+#define ONEWIRE_T_RESET_END 410 // presence sample to end of the reset
+
+/* Machine cycles in a number of microseconds, rounded */
+#define ONEWIRE_CYCLES(us)  ((uint16_t)(((us) * (CLOCK_SOURCE / 1200UL) + 5000UL) / 10000UL))
+
+/* DJNZ iterations of 2 machine cycles for a wait, at least 1 */
+#define ONEWIRE_LOOPS(us)   ((uint8_t)(ONEWIRE_CYCLES(us) > ONEWIRE_OVERHEAD + 2 ? (ONEWIRE_CYCLES(us) - ONEWIRE_OVERHEAD) / 2 : 1))
+
+/* Timed wait, the two polls keep the host emulation at 2 cycles per iteration */
+#define ONEWIRE_WAIT(us)    do { uint8_t n_ = ONEWIRE_LOOPS(us); while (--n_) { IDLE_POLL(); IDLE_POLL(); } } while (0)
+
+/* Every wait passed to ONEWIRE_WAIT must fit the 8 bit loop counter, add new ones here */
+#define ONEWIRE_FITS(us)    (ONEWIRE_CYCLES(us) <= 2 * 255 ? 1 : -1)
+typedef char onewireLoopCheck[ONEWIRE_FITS(ONEWIRE_T_LOW1) + ONEWIRE_FITS(ONEWIRE_T_HIGH1) +
+                              ONEWIRE_FITS(ONEWIRE_T_LOW0) + ONEWIRE_FITS(ONEWIRE_T_HIGH0) +
+                              ONEWIRE_FITS(ONEWIRE_T_SAMPLE) + ONEWIRE_FITS(ONEWIRE_T_READ_END) +
+                              ONEWIRE_FITS(ONEWIRE_T_PRESENCE) == 7 ? 1 : -1];
+
+/* Bit position of the last unresolved branch of the ROM search, 0 when there is none */
+static uint8_t searchLast;
+
+/* Set when the previous search returned the last device */
+static __bit searchDone;
+
+/* Nibble table for the reflected polynomial 0x8C */
+static __code const uint8_t crc8Table[16] =
+{
+    0x00, 0x9D, 0x23, 0xBE, 0x46, 0xDB, 0x65, 0xF8,
+    0x8C, 0x11, 0xAF, 0x32, 0xCA, 0x57, 0xE9, 0x74
+};
+
+/*
+ *@fn        -   onewireReset
+ *
+ *@brief     -   Function to send a reset pulse and check for a presence pulse
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t, ONEWIRE_OK or ONEWIRE_NO_DEVICE
+ */
+uint8_t onewireReset(void)
+{
+    uint8_t ea;
+    uint8_t present;
+
+    GPIO_PIN_CLEAR(ONEWIRE_PIN);
+    delay_us(ONEWIRE_T_RESET); // a longer pulse is still a reset, interrupts may run here
+
+    ea = EA;
+    EA = 0;
+    GPIO_PIN_SET(ONEWIRE_PIN);
+    ONEWIRE_WAIT(ONEWIRE_T_PRESENCE);
+    present = !GPIO_PIN_READ(ONEWIRE_PIN);
+    EA = ea;
+
+    delay_us(ONEWIRE_T_RESET_END);
+
+    return present ? ONEWIRE_OK : ONEWIRE_NO_DEVICE;
+}
+
+/*
+ *@fn        -   onewireWriteBit
+ *
+ *@brief     -   Function to send one write slot
+ *
+ *@param[1]  -   Bit value
+ *
+ *return     -   void
+ */
+void onewireWriteBit(uint8_t value)
+{
+    uint8_t ea = EA;
+
+    EA = 0;
+    GPIO_PIN_CLEAR(ONEWIRE_PIN);
+    if (value)
+    {
+        ONEWIRE_WAIT(ONEWIRE_T_LOW1);
+        GPIO_PIN_SET(ONEWIRE_PIN);
+        EA = ea;
+        ONEWIRE_WAIT(ONEWIRE_T_HIGH1);
+    }
+    else
+    {
+        ONEWIRE_WAIT(ONEWIRE_T_LOW0);
+        GPIO_PIN_SET(ONEWIRE_PIN);
+        EA = ea;
+        ONEWIRE_WAIT(ONEWIRE_T_HIGH0);
+    }
+}
+
+/*
+ *@fn        -   onewireReadBit
+ *
+ *@brief     -   Function to send one read slot
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t, bit value
+ */
+uint8_t onewireReadBit(void)
+{
+    uint8_t ea = EA;
+    uint8_t value;
+
+    EA = 0;
+    GPIO_PIN_CLEAR(ONEWIRE_PIN);
+    ONEWIRE_WAIT(ONEWIRE_T_LOW1);
+    GPIO_PIN_SET(ONEWIRE_PIN);
+    ONEWIRE_WAIT(ONEWIRE_T_SAMPLE);
+    value = GPIO_PIN_READ(ONEWIRE_PIN);
+    EA = ea;
+    ONEWIRE_WAIT(ONEWIRE_T_READ_END);
+
+    return value;
+}
+
+/*
+ *@fn        -   onewireWriteByte
+ *
+ *@brief     -   Function to send a byte LSB first
+ *
+ *@param[1]  -   Byte to send
+ *
+ *return     -   void
+ */
+void onewireWriteByte(uint8_t b)
+{
+    uint8_t i;
+
+    for (i = 0; i < 8; i++)
+    {
+        onewireWriteBit(b & 0x01);
+        b >>= 1;
+    }
+}
+
+/*
+ *@fn        -   onewireReadByte
+ *
+ *@brief     -   Function to read a byte LSB first
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t
+ */
+uint8_t onewireReadByte(void)
+{
+    uint8_t i;
+    uint8_t b = 0;
+
+    for (i = 0; i < 8; i++)
+    {
+        b >>= 1;
+        if (onewireReadBit())
+        {
+            b |= 0x80;
+        }
+    }
+
+    return b;
+}
+
+/*
+ *@fn        -   onewireSelect
+ *
+ *@brief     -   Function to reset the bus and address one device, or all of them
+ *
+ *@param[1]  -   ROM code of the device, 0 to skip ROM
+ *
+ *return     -   uint8_t, ONEWIRE_OK or ONEWIRE_NO_DEVICE
+ */
+uint8_t onewireSelect(const uint8_t *rom)
+{
+    uint8_t i;
+
+    if (onewireReset() != ONEWIRE_OK)
+    {
+        return ONEWIRE_NO_DEVICE;
+    }
+
+    if (!rom)
+    {
+        onewireWriteByte(ONEWIRE_SKIP_ROM);
+        return ONEWIRE_OK;
+    }
+
+    onewireWriteByte(ONEWIRE_MATCH_ROM);
+    for (i = 0; i < ONEWIRE_ROM_SIZE; i++)
+    {
+        onewireWriteByte(rom[i]);
+    }
+
+    return ONEWIRE_OK;
+}
+
+/*
+ *@fn        -   onewireSearchBegin
+ *
+ *@brief     -   Function to restart the ROM search from the first device
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+void onewireSearchBegin(void)
+{
+    searchLast = 0;
+    searchDone = 0;
+}
+
+/*
+ *@fn        -   onewireSearch
+ *
+ *@brief     -   Function to find the next device on the bus, Maxim AN187. Each of the 64
+ *               bits is read with its complement: different values mean every remaining
+ *               device agrees, two zeros are a branch. Branches below the last one repeat
+ *               the previous path, the last one now takes 1 and new ones take 0.
+ *
+ *@param[1]  -   ROM code buffer, holds the previous result between calls
+ *
+ *return     -   uint8_t, ONEWIRE_OK, ONEWIRE_NO_DEVICE when done or ONEWIRE_CRC_ERROR
+ */
+uint8_t onewireSearch(uint8_t *rom)
+{
+    uint8_t n;
+    uint8_t mask = 0x01;
+    uint8_t lastZero = 0;
+    uint8_t *p = rom;
+    uint8_t id;
+    uint8_t cmp;
+
+    if (searchDone || onewireReset() != ONEWIRE_OK)
+    {
+        onewireSearchBegin();
+        return ONEWIRE_NO_DEVICE;
+    }
+
+    onewireWriteByte(ONEWIRE_SEARCH_ROM);
+
+    for (n = 1; n <= 8 * ONEWIRE_ROM_SIZE; n++)
+    {
+        id = onewireReadBit();
+        cmp = onewireReadBit();
+
+        if (id && cmp)
+        {
+            // Nobody answered, the devices left the bus during the search
+            onewireSearchBegin();
+            return ONEWIRE_NO_DEVICE;
+        }
+
+        if (id == cmp)
+        {
+            if (n < searchLast)
+            {
+                id = (*p & mask) ? 1 : 0;
+            }
+            else
+            {
+                id = (n == searchLast);
+            }
+            if (!id)
+            {
+                lastZero = n;
+            }
+        }
+
+        if (id)
+        {
+            *p |= mask;
+        }
+        else
+        {
+            *p &= ~mask;
+        }
+        onewireWriteBit(id);
+
+        mask <<= 1;
+        if (!mask)
+        {
+            mask = 0x01;
+            p++;
+        }
+    }
+
+    searchLast = lastZero;
+    searchDone = (lastZero == 0);
+
+    return onewireCrc8(0, rom, ONEWIRE_ROM_SIZE) ? ONEWIRE_CRC_ERROR : ONEWIRE_OK;
+}
+
+/*
+ *@fn        -   onewireCrc8
+ *
+ *@brief     -   Function to update the Dallas/Maxim CRC-8 a nibble at a time
+ *
+ *@param[1]  -   CRC so far, 0 to start
+ *@param[2]  -   Data reference
+ *@param[3]  -   Number of bytes
+ *
+ *return     -   uint8_t
+ */
+uint8_t onewireCrc8(uint8_t crc, const uint8_t *buf, uint8_t len)
+{
+    while (len--)
+    {
+        crc ^= *buf++;
+        crc = (crc >> 4) ^ crc8Table[crc & 0x0F];
+        crc = (crc >> 4) ^ crc8Table[crc & 0x0F];
+    }
+
+    return crc;
+}
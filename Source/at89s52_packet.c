@@ -0,0 +1,299 @@
+/*
+ * at89s52_packet.c
+ * Description: This file contains the framed packet layer over the UART, COBS framing with a
+ *              CRC-16 and a byte at a time decoder that writes straight into the caller buffer.
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for function declarations
+#include "at89s52_packet.h"
+// Library for the UART the frames go out on
+#include "at89s52_serial.h"
+
+/* Decoder states */
+#define RX_OFF      0   // no buffer
+#define RX_HUNT     1   // armed mid frame, waiting for a delimiter
+#define RX_IDLE     2   // armed at a frame boundary
+#define RX_FRAME    3   // decoding a frame
+#define RX_DONE     4   // holding a good frame
+
+/* CRC-16/CCITT of one nibble, 32 bytes of code instead of 512 for a byte table */
+static __code const uint16_t crcTable[16] =
+{
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+/* Expanded in place, the decoder runs in the ISR and must not share a function with main */
+#define CRC_BYTE(crc, b)                                                        \
+    do {                                                                        \
+        (crc) = ((crc) << 4) ^ crcTable[((crc) >> 12) ^ ((b) >> 4)];            \
+        (crc) = ((crc) << 4) ^ crcTable[((crc) >> 12) ^ ((b) & 0x0F)];          \
+    } while (0)
+
+static uint8_t *rxBuffer;
+static uint8_t rxSize;
+static volatile uint8_t rxLen;
+static volatile uint8_t rxState = RX_OFF;
+static uint8_t rxRemain;        // data bytes left in the current COBS group
+static uint16_t rxCrc;          // runs over the CRC bytes too, ends at 0 for a good frame
+static uint16_t rxErrors;
+static __bit rxZero;            // the current group ends with an implied zero
+static __bit rxOverflow;
+static volatile __bit rxMidFrame; // bytes went by since the last delimiter
+
+/*
+ *@fn        -   packetCrc
+ *
+ *@brief     -   Function to run the CRC-16 over a block, nibble table in code memory
+ *
+ *@param[1]  -   Running CRC, PACKET_CRC_INIT for a new block
+ *@param[2]  -   Data reference
+ *@param[3]  -   Number of bytes
+ *
+ *return     -   uint16_t
+ */
+uint16_t packetCrc(uint16_t crc, const uint8_t *buf, uint8_t len)
+{
+    uint8_t b;
+
+    while (len--)
+    {
+        b = *buf++;
+        CRC_BYTE(crc, b);
+    }
+
+    return crc;
+}
+
+/*
+ *@fn        -   frameByte
+ *
+ *@brief     -   Function to get a byte of the unencoded frame, payload then CRC high and low
+ *
+ *@param[1]  -   Payload reference
+ *@param[2]  -   Payload length
+ *@param[3]  -   CRC of the payload
+ *@param[4]  -   Index into the frame
+ *
+ *return     -   uint8_t
+ */
+static uint8_t frameByte(const uint8_t *payload, uint8_t len, uint16_t crc, uint16_t i)
+{
+    if (i < len)
+    {
+        return payload[i];
+    }
+
+    return (i == len) ? (uint8_t)(crc >> 8) : (uint8_t)crc;
+}
+
+/*
+ *@fn        -   packetSend
+ *
+ *@brief     -   Function to send one frame with serialTx, encoded on the fly without a copy
+ *
+ *@param[1]  -   Payload reference
+ *@param[2]  -   Payload length, at most PACKET_MAX_PAYLOAD
+ *
+ *return     -   void
+ */
+void packetSend(const uint8_t *payload, uint8_t len)
+{
+    uint16_t crc = packetCrc(PACKET_CRC_INIT, payload, len);
+    uint16_t total = (uint16_t)len + 2;
+    uint16_t start = 0;
+    uint16_t end;
+    uint16_t i;
+
+    if (len > PACKET_MAX_PAYLOAD)
+    {
+        return;
+    }
+
+    // One COBS group per run of non-zero bytes, a full group of 254 has no implied zero
+    for (;;)
+    {
+        end = start;
+        while (end < total && end - start < 254 && frameByte(payload, len, crc, end) != 0)
+        {
+            end++;
+        }
+
+        serialTx((uint8_t)(end - start + 1));
+        for (i = start; i < end; i++)
+        {
+            serialTx(frameByte(payload, len, crc, i));
+        }
+
+        if (end >= total)
+        {
+            break;
+        }
+        start = (end - start == 254) ? end : end + 1;
+    }
+
+    serialTx(0x00);
+}
+
+/*
+ *@fn        -   packetRxBegin
+ *
+ *@brief     -   Function to arm the decoder with the buffer the next frame is decoded into
+ *
+ *@param[1]  -   Buffer reference
+ *@param[2]  -   Buffer size, PACKET_RX_SIZE(largest payload)
+ *
+ *return     -   void
+ */
+void packetRxBegin(uint8_t *buffer, uint8_t size)
+{
+    uint8_t ea = EA;
+
+    EA = 0;
+    rxBuffer = buffer;
+    rxSize = size;
+    rxLen = 0;
+    rxState = rxMidFrame ? RX_HUNT : RX_IDLE;
+    EA = ea;
+}
+
+/*
+ *@fn        -   rxStore
+ *
+ *@brief     -   Function to append a decoded byte to the receive buffer and the running CRC
+ *
+ *@param[1]  -   Decoded byte
+ *
+ *return     -   void
+ */
+static void rxStore(uint8_t b)
+{
+    if (rxLen < rxSize)
+    {
+        rxBuffer[rxLen++] = b;
+        CRC_BYTE(rxCrc, b);
+    }
+    else
+    {
+        rxOverflow = 1;
+    }
+}
+
+/*
+ *@fn        -   packetRxByte
+ *
+ *@brief     -   Function to feed one received byte to the decoder
+ *
+ *@param[1]  -   Received byte
+ *
+ *return     -   uint8_t, PACKET_PENDING, PACKET_DONE or PACKET_ERROR
+ */
+uint8_t packetRxByte(uint8_t c)
+{
+    if (c == 0x00)
+    {
+        rxMidFrame = 0;
+        if (rxState == RX_FRAME)
+        {
+            if (rxRemain == 0 && !rxOverflow && rxLen >= 2 && rxCrc == 0)
+            {
+                rxState = RX_DONE;
+                return PACKET_DONE;
+            }
+            rxErrors++;
+            rxState = RX_IDLE;
+            return PACKET_ERROR;
+        }
+        if (rxState == RX_HUNT)
+        {
+            rxState = RX_IDLE;
+        }
+        return PACKET_PENDING;
+    }
+
+    rxMidFrame = 1;
+    if (rxState == RX_IDLE)
+    {
+        // First code byte of a frame
+        rxLen = 0;
+        rxCrc = PACKET_CRC_INIT;
+        rxOverflow = 0;
+        rxZero = 0;
+        rxRemain = 0;
+        rxState = RX_FRAME;
+    }
+    else if (rxState != RX_FRAME)
+    {
+        return PACKET_PENDING;
+    }
+
+    if (rxRemain == 0)
+    {
+        // Code byte, closes the previous group and opens the next
+        if (rxZero)
+        {
+            rxStore(0x00);
+        }
+        rxRemain = c - 1;
+        rxZero = (c != 0xFF);
+    }
+    else
+    {
+        rxStore(c);
+        rxRemain--;
+    }
+
+    return PACKET_PENDING;
+}
+
+/*
+ *@fn        -   packetRxReady
+ *
+ *@brief     -   Function to check whether a good frame is waiting in the buffer
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t
+ */
+uint8_t packetRxReady(void)
+{
+    return rxState == RX_DONE;
+}
+
+/*
+ *@fn        -   packetRxLength
+ *
+ *@brief     -   Function to get the payload length of the frame in the buffer
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t
+ */
+uint8_t packetRxLength(void)
+{
+    return (rxState == RX_DONE) ? rxLen - 2 : 0;
+}
+
+/*
+ *@fn        -   packetRxErrors
+ *
+ *@brief     -   Function to get the number of frames dropped for CRC, overflow or framing
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint16_t
+ */
+uint16_t packetRxErrors(void)
+{
+    uint16_t count;
+    uint8_t ea = EA;
+
+    EA = 0;
+    count = rxErrors;
+    EA = ea;
+
+    return count;
+}
@@ -0,0 +1,273 @@
+/*
+ * at89s52_pwm.c
+ * Description: This file contains the edge scheduled software PWM. The duties are sorted into
+ *              a list of clear events once per change, and Timer 0 is reloaded to interrupt
+ *              only at the period start and at each distinct edge, so the ISR rate follows the
+ *              number of edges and not the resolution.
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for function declarations
+#include "at89s52_pwm.h"
+// Library for the constant port writes
+#include "at89s52_gpio.h"
+
+/* Machine cycles Timer 0 is stopped while the ISR re-arms it, added back to the reload */
+#ifndef PWM_T0_FIXUP
+#define PWM_T0_FIXUP 8
+#endif
+
+/* Port bits owned by the PWM */
+#define PWM_MASK    ((uint8_t)((1U << PWM_CHANNELS) - 1))
+
+/*
+ * One more expansion so PWM_PORT becomes a port name before the GPIO macros paste it. With
+ * GPIO_USE_SHADOW the edges go through the port shadow, so main code writing other pins of
+ * PWM_PORT does not put stale channel levels back.
+ */
+#define PWM_SET_CLEAR(port, set, clr)   GPIO_PORT_SET_CLEAR(port, set, clr)
+#ifdef GPIO_USE_SHADOW
+#define PWM_CLEAR(port, clr)            GPIO_PORT_SET_CLEAR(port, 0, clr)
+#else
+#define PWM_CLEAR(port, clr)            ((port) &= (uint8_t)~(clr))
+#endif
+
+typedef char pwmChannelCheck[(PWM_CHANNELS >= 1 && PWM_CHANNELS <= 8) ? 1 : -1];
+typedef char pwmStepCheck[(PWM_STEP_COUNTS >= 1 && PWM_STEPS <= 255) ? 1 : -1];
+typedef char pwmPeriodCheck[((CLOCK_SOURCE / 12UL) / PWM_FREQ <= 65535UL && PWM_PERIOD_COUNTS >= 2 * PWM_MIN_GAP) ? 1 : -1];
+typedef char pwmTimerCheck[TICK_TIMER != T0 ? 1 : -1];
+
+/*
+ * One period. Event 0 is the period start and sets setMask; event i after it clears
+ * clearMask[i - 1]. reload[i] is the Timer 0 load for the interval after event i.
+ */
+typedef struct
+{
+    uint8_t events;
+    uint8_t setMask;
+    uint8_t clearMask[PWM_CHANNELS];
+    uint16_t reload[PWM_CHANNELS + 1];
+} pwmSchedule_t;
+
+static PWM_SCHEDULE_SPACE pwmSchedule_t schedule[2];
+static uint8_t duties[PWM_CHANNELS];
+
+static volatile uint8_t active;     // schedule the ISR runs
+static uint8_t event;               // next event of the active schedule
+static volatile __bit swapPending;  // the other schedule is ready for the next period
+
+/*
+ *@fn        -   pwmBuild
+ *
+ *@brief     -   Function to sort the duties into the schedule the ISR is not running and
+ *               hand it over at the next period start
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void pwmBuild(void)
+{
+    PWM_SCHEDULE_SPACE pwmSchedule_t *s;
+    uint8_t order[PWM_CHANNELS];
+    uint8_t n = 0;
+    uint8_t i;
+    uint8_t j;
+    uint8_t ch;
+    uint16_t at;
+    uint16_t last = 0;
+
+    // Taken back first so the ISR can not swap in a schedule that is half written
+    swapPending = 0;
+    s = &schedule[active ^ 1];
+
+    s->setMask = 0;
+    for (ch = 0; ch < PWM_CHANNELS; ch++)
+    {
+        if (duties[ch] == 0)
+        {
+            continue;
+        }
+        s->setMask |= 1 << ch;
+        if (duties[ch] >= PWM_STEPS)
+        {
+            continue; // on for the whole period, never cleared
+        }
+
+        // Insertion sort by duty, there are at most 8 channels
+        for (i = n; i > 0 && duties[order[i - 1]] > duties[ch]; i--)
+        {
+            order[i] = order[i - 1];
+        }
+        order[i] = ch;
+        n++;
+    }
+
+    j = 0;
+    for (i = 0; i < n; i++)
+    {
+        ch = order[i];
+        at = duties[ch] * PWM_STEP_COUNTS;
+
+        // Keep a PWM_MIN_GAP interval after the period start and before the next one
+        if (at < PWM_MIN_GAP)
+        {
+            at = PWM_MIN_GAP;
+        }
+        else if (at > PWM_PERIOD_COUNTS - PWM_MIN_GAP)
+        {
+            at = PWM_PERIOD_COUNTS - PWM_MIN_GAP;
+        }
+
+        if (j > 0 && at - last < PWM_MIN_GAP)
+        {
+            // Too close to the previous edge to take another interrupt, clear with it
+            s->clearMask[j - 1] |= 1 << ch;
+            continue;
+        }
+
+        s->reload[j] = 0 - (at - last);
+        s->clearMask[j] = 1 << ch;
+        last = at;
+        j++;
+    }
+
+    s->reload[j] = 0 - (PWM_PERIOD_COUNTS - last);
+    s->events = j;
+
+    swapPending = 1;
+}
+
+/*
+ *@fn        -   pwmInit
+ *
+ *@brief     -   Function to start the PWM on Timer 0 with every channel off
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+void pwmInit(void)
+{
+    uint8_t ch;
+
+    for (ch = 0; ch < PWM_CHANNELS; ch++)
+    {
+        duties[ch] = 0;
+    }
+    PWM_CLEAR(PWM_PORT, PWM_MASK);
+
+    timer0Busy = 1;
+    active = 0;
+    event = 0;
+    pwmBuild();
+
+    // The first interrupt is a period start and swaps the schedule in
+    timerInterruptConfig(T0, 0 - PWM_PERIOD_COUNTS, ENABLE);
+}
+
+/*
+ *@fn        -   pwmStop
+ *
+ *@brief     -   Function to stop the PWM and drive every channel low
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+void pwmStop(void)
+{
+    // Only Timer 0 is ours, timerInterruptConfig(DISABLE) would clear EA for every other ISR
+    ET0 = 0;
+    TR0 = 0;
+    TF0 = 0;
+    PWM_CLEAR(PWM_PORT, PWM_MASK);
+    timer0Busy = 0;
+}
+
+/*
+ *@fn        -   pwmWrite
+ *
+ *@brief     -   Function to set the duty of one channel
+ *
+ *@param[1]  -   Channel, 0 to PWM_CHANNELS - 1
+ *@param[2]  -   Duty, 0 to PWM_STEPS
+ *
+ *return     -   void
+ */
+void pwmWrite(uint8_t channel, uint8_t duty)
+{
+    if (channel < PWM_CHANNELS)
+    {
+        duties[channel] = duty;
+        pwmBuild();
+    }
+}
+
+/*
+ *@fn        -   pwmWriteAll
+ *
+ *@brief     -   Function to set the duty of every channel
+ *
+ *@param[1]  -   PWM_CHANNELS duties, 0 to PWM_STEPS
+ *
+ *return     -   void
+ */
+void pwmWriteAll(const uint8_t *duty)
+{
+    uint8_t ch;
+
+    for (ch = 0; ch < PWM_CHANNELS; ch++)
+    {
+        duties[ch] = duty[ch];
+    }
+    pwmBuild();
+}
+
+/*
+ *@fn        -   pwmIsr
+ *
+ *@brief     -   Timer 0 interrupt service routine, runs once per distinct edge
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+void pwmIsr(void) __interrupt(TIMER0_VECTOR)
+{
+    PWM_SCHEDULE_SPACE pwmSchedule_t *s;
+    uint16_t reload;
+    uint16_t next;
+
+    if (event == 0)
+    {
+        // Period start, the only point where a new schedule is taken
+        if (swapPending)
+        {
+            active ^= 1;
+            swapPending = 0;
+        }
+        s = &schedule[active];
+        // ANL/ORL work on the port latch. A MOV of a port read would latch low any pin outside
+        // the mask that is an input being pulled low
+        PWM_SET_CLEAR(PWM_PORT, s->setMask, PWM_MASK & ~s->setMask);
+    }
+    else
+    {
+        s = &schedule[active];
+        PWM_CLEAR(PWM_PORT, s->clearMask[event - 1]);
+    }
+
+    // Add the interval to the count that built up since the overflow so latency does not drift,
+    // fetched first to keep the schedule lookup out of the window Timer 0 is stopped
+    reload = s->reload[event] + PWM_T0_FIXUP;
+    TR0 = 0;
+    next = (((uint16_t)TH0 << 8) | TL0) + reload;
+    TL0 = next & 0xFF;
+    TH0 = (next >> 8) & 0xFF;
+    TR0 = 1;
+
+    event = (event == s->events) ? 0 : event + 1;
+}
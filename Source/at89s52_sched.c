@@ -0,0 +1,234 @@
+/*
+ * at89s52_sched.c
+ * Description: This file contains a cooperative run-to-completion scheduler. The tick ISR counts
+ *              task periods down and sets a bit per released task in readyMask, the main loop
+ *              runs the highest set bit found through a nibble lookup table. Run times are
+ *              measured with micros(), which reads the tick timer (Timer 2 by default).
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for function declarations
+#include "at89s52_sched.h"
+
+typedef struct
+{
+    schedTask_t task;
+    uint16_t period;
+    uint16_t countdown;
+    uint16_t wcet;
+} schedEntry_t;
+
+/* Highest set bit of a nibble */
+static const __code uint8_t nibbleMsb[16] = { 0, 0, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3 };
+static const __code uint8_t bitMask[8] = { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80 };
+
+static schedEntry_t tasks[SCHED_MAX_TASKS];
+static volatile uint8_t taskMask;   // registered tasks
+static volatile uint8_t readyMask;  // released tasks, set by the ISR and cleared by the dispatcher
+
+static uint32_t windowStart;
+static uint32_t busyUs;
+static uint8_t idlePercent = 100;
+
+/*
+ *@fn        -   schedTick
+ *
+ *@brief     -   Function to release the tasks whose period elapsed, runs from the tick ISR
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void schedTick(void)
+{
+    uint8_t i;
+    uint8_t mask = taskMask;
+
+    for (i = 0; mask; i++, mask >>= 1)
+    {
+        if ((mask & 1) && --tasks[i].countdown == 0)
+        {
+            tasks[i].countdown = tasks[i].period;
+            readyMask |= bitMask[i];
+        }
+    }
+}
+
+/*
+ *@fn        -   schedInit
+ *
+ *@brief     -   Function to clear the task table and attach the scheduler to the tick
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t, 0 if the tick has no free hook
+ */
+uint8_t schedInit(void)
+{
+    taskMask = 0;
+    readyMask = 0;
+    busyUs = 0;
+    idlePercent = 100;
+    windowStart = micros();
+
+    return tickAttach(schedTick);
+}
+
+/*
+ *@fn        -   schedAdd
+ *
+ *@brief     -   Function to register a periodic task
+ *
+ *@param[1]  -   Priority 0 to 7, each level holds one task
+ *@param[2]  -   Period in ticks, at least 1
+ *@param[3]  -   Task function
+ *
+ *return     -   uint8_t, 0 if the priority is taken or a parameter is invalid
+ */
+uint8_t schedAdd(uint8_t priority, uint16_t period, schedTask_t task)
+{
+    uint8_t ea = EA;
+
+    if (priority >= SCHED_MAX_TASKS || period == 0 || (taskMask & bitMask[priority]))
+    {
+        return 0;
+    }
+
+    tasks[priority].task = task;
+    tasks[priority].period = period;
+    tasks[priority].countdown = period;
+    tasks[priority].wcet = 0;
+
+    EA = 0;
+    taskMask |= bitMask[priority];
+    EA = ea;
+
+    return 1;
+}
+
+/*
+ *@fn        -   schedRemove
+ *
+ *@brief     -   Function to unregister the task at a priority level
+ *
+ *@param[1]  -   Priority 0 to 7
+ *
+ *return     -   void
+ */
+void schedRemove(uint8_t priority)
+{
+    uint8_t ea = EA;
+
+    if (priority >= SCHED_MAX_TASKS)
+    {
+        return;
+    }
+
+    EA = 0;
+    taskMask &= ~bitMask[priority];
+    readyMask &= ~bitMask[priority];
+    EA = ea;
+}
+
+/*
+ *@fn        -   schedDispatch
+ *
+ *@brief     -   Function to run the highest priority ready task once
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t, 0 if no task was ready
+ */
+uint8_t schedDispatch(void)
+{
+    uint8_t ready = readyMask;
+    uint8_t priority;
+    uint8_t ea;
+    uint32_t start, elapsed;
+
+    start = micros();
+
+    if (ready)
+    {
+        priority = (ready & 0xF0) ? 4 + nibbleMsb[ready >> 4] : nibbleMsb[ready];
+
+        ea = EA;
+        EA = 0;
+        readyMask &= ~bitMask[priority];
+        EA = ea;
+
+        tasks[priority].task();
+
+        elapsed = micros() - start;
+        if (elapsed > tasks[priority].wcet)
+        {
+            tasks[priority].wcet = elapsed > 0xFFFF ? 0xFFFF : (uint16_t)elapsed;
+        }
+        busyUs += elapsed;
+    }
+
+    // Close the idle measurement window once it is long enough
+    elapsed = micros() - windowStart;
+    if (elapsed >= SCHED_WINDOW_US)
+    {
+        idlePercent = busyUs >= elapsed ? 0 : 100 - (uint8_t)((busyUs * 100) / elapsed);
+        busyUs = 0;
+        windowStart += elapsed;
+    }
+
+    return ready ? 1 : 0;
+}
+
+/*
+ *@fn        -   schedRun
+ *
+ *@brief     -   Function to dispatch tasks forever, calls SCHED_IDLE() when none is ready
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+void schedRun(void)
+{
+    while (1)
+    {
+        if (!schedDispatch())
+        {
+            SCHED_IDLE();
+        }
+    }
+}
+
+/*
+ *@fn        -   schedWcet
+ *
+ *@brief     -   Function to get the longest measured run time of a task
+ *
+ *@param[1]  -   Priority 0 to 7
+ *
+ *return     -   uint16_t, microseconds, saturates at 65535
+ */
+uint16_t schedWcet(uint8_t priority)
+{
+    if (priority >= SCHED_MAX_TASKS)
+    {
+        return 0;
+    }
+    return tasks[priority].wcet;
+}
+
+/*
+ *@fn        -   schedIdlePercent
+ *
+ *@brief     -   Function to get the share of the last window spent outside tasks
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t, 0 to 100
+ */
+uint8_t schedIdlePercent(void)
+{
+    return idlePercent;
+}
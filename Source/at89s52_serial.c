@@ -1,6 +1,9 @@
-#include "at89s52_serial.h" // 10526 baud rate
+#include "at89s52_serial.h"
+// Library for the Timer 1/Timer 2 baud rate generators
+#include "at89s52_timer.h"
+// Library for the formatted output engine behind serialPrint
+#include "at89s52_format.h"
 
-static void intToStr(int num, char *str);
 /*
  * at89s52_serial.c
  * Description:     This file contains the functions to configure and send/receive data using UART
@@ -9,10 +12,55 @@ static void intToStr(int num, char *str);
  * License:         Open source
  */
 
+#ifdef SERIAL_USE_INTERRUPT
+
+#define SERIAL_TX_MASK (SERIAL_TX_BUFFER_SIZE - 1)
+#define SERIAL_RX_MASK (SERIAL_RX_BUFFER_SIZE - 1)
+
+/* Compile time check, indexes are free running uint8_t so sizes must be powers of two <= 128 */
+typedef char serialTxSizeCheck[((SERIAL_TX_BUFFER_SIZE & SERIAL_TX_MASK) == 0 && SERIAL_TX_BUFFER_SIZE <= 128) ? 1 : -1];
+typedef char serialRxSizeCheck[((SERIAL_RX_BUFFER_SIZE & SERIAL_RX_MASK) == 0 && SERIAL_RX_BUFFER_SIZE <= 128) ? 1 : -1];
+
+/* Head is written only by the producer and tail only by the consumer */
+static SERIAL_BUFFER_SPACE volatile uint8_t txBuffer[SERIAL_TX_BUFFER_SIZE];
+static SERIAL_BUFFER_SPACE volatile uint8_t rxBuffer[SERIAL_RX_BUFFER_SIZE];
+static volatile uint8_t txHead, txTail;
+static volatile uint8_t rxHead, rxTail;
+static volatile __bit txBusy; // set while the ISR is draining txBuffer
+
+#endif // SERIAL_USE_INTERRUPT
+
+/* Baud rate generator picked by the last serialInit/serialInitTimer call */
+static uint8_t baudTimer = T1;
+static uint16_t baudReload;
+static uint8_t baudSmod;
+
+/* Multiprocessor mode state, see serialMultiprocessorInit */
+static volatile __bit mpNode;   // mode 3 with address bytes handled by the driver
+static __bit mpFilter;          // not a master, drop data for other nodes
+static uint8_t mpAddress;
+
+/*
+ *@fn        -   baudDiff
+ *
+ *@brief     -   Function to get the distance between two baud rates
+ *
+ *@param[1]  -   Baud rate a generator produces
+ *@param[2]  -   Requested baud rate
+ *
+ *return     -   uint32_t
+ */
+static uint32_t baudDiff(uint32_t actual, uint32_t baud)
+{
+    return actual > baud ? actual - baud : baud - actual;
+}
+
 /*
  *@fn        -   serialInit
  *
- *@brief     -   Function to configure the UART
+ *@brief     -   Function to configure the UART, picks the baud rate generator with the
+ *               smallest error: Timer 2 when the tick does not own it, else Timer 1 with or
+ *               without SMOD doubling. Timer 2 wins ties so Timer 1 stays free
  *
  *@param[1]  -   Parameter takes the baud rate value
  *
@@ -20,15 +68,223 @@ static void intToStr(int num, char *str);
  */
 void serialInit(uint32_t baud)
 {
-    TMOD &= 0x0F;
-    TMOD = 0x20;
-    uint8_t value = CLOCK_SOURCE / (12 * 32 * baud);
-    value = 256 - value;
-    TH1 = value;
-    TR1 = 1;
+    uint32_t base, div, actual, bestDiff;
+    uint8_t smod;
+    uint8_t timer = T1;
+    uint16_t reload = 0;
+    uint8_t bestSmod = 0;
+
+    bestDiff = 0xFFFFFFFFUL;
+
+    // Timer 1 mode 2: baud = CLOCK_SOURCE / ((SMOD ? 192 : 384) * (256 - TH1))
+    for (smod = 0; smod < 2; smod++)
+    {
+        base = CLOCK_SOURCE / (smod ? 192UL : 384UL);
+        div = (base + baud / 2) / baud;
+        if (div < 1)
+        {
+            div = 1;
+        }
+        else if (div > 256)
+        {
+            div = 256;
+        }
+
+        actual = base / div;
+        if (baudDiff(actual, baud) < bestDiff)
+        {
+            bestDiff = baudDiff(actual, baud);
+            reload = (uint16_t)(256 - div);
+            bestSmod = smod;
+        }
+    }
+
+#if TICK_TIMER != T2
+    // Timer 2 baud rate mode: baud = CLOCK_SOURCE / (32 * (65536 - RCAP2))
+    div = (CLOCK_SOURCE / 32UL + baud / 2) / baud;
+    if (div >= 1 && div <= 65535)
+    {
+        actual = (CLOCK_SOURCE / 32UL) / div;
+        if (baudDiff(actual, baud) <= bestDiff)
+        {
+            timer = T2;
+            reload = (uint16_t)(65536UL - div);
+            bestSmod = 0;
+        }
+    }
+#endif
+
+    serialInitTimer(timer, reload, bestSmod);
+}
+
+/*
+ *@fn        -   serialInitTimer
+ *
+ *@brief     -   Function to configure the UART with a known generator and reload,
+ *               use SERIAL_T1_RELOAD/SERIAL_T2_RELOAD to get it at compile time
+ *
+ *@param[1]  -   T1 or T2
+ *@param[2]  -   TH1 value for Timer 1, RCAP2 value for Timer 2
+ *@param[3]  -   SMOD bit for Timer 1, ignored for Timer 2
+ *
+ *return     -   void
+ */
+void serialInitTimer(uint8_t Tx, uint16_t reload, uint8_t smod)
+{
+    baudTimer = Tx;
+    baudReload = reload;
+    baudSmod = smod;
+
+    if (Tx == T2)
+    {
+        PCON &= 0x7F;
+        timer2BaudConfig(reload);
+    }
+    else
+    {
+        if (smod)
+        {
+            PCON |= 0x80;
+        }
+        else
+        {
+            PCON &= 0x7F;
+        }
+
+        RCLK = 0;
+        TCLK = 0;
+        timerConfig(T1, TIMER, TIMER_MODE2);
+        TH1 = reload & 0xFF;
+        TL1 = reload & 0xFF;
+        TR1 = 1;
+    }
 
     SCON = 0x50;
+    mpNode = 0;
+#ifdef SERIAL_USE_INTERRUPT
+    txHead = txTail = 0;
+    rxHead = rxTail = 0;
+    txBusy = 0;
+    ES = 1;
+    EA = 1;
+#else
     TI = 1;
+#endif
+}
+
+/*
+ *@fn        -   serialMultiprocessorInit
+ *
+ *@brief     -   Function to switch the UART to 9 bit mode 3 as a bus node, call after serialInit
+ *
+ *@param[1]  -   Node address, SERIAL_MP_BROADCAST for a master that hears every byte
+ *
+ *return     -   void
+ */
+void serialMultiprocessorInit(uint8_t address)
+{
+    uint8_t ea = EA;
+
+    EA = 0;
+    mpAddress = address;
+    mpFilter = (address != SERIAL_MP_BROADCAST);
+    mpNode = 1;
+    TB8 = 0;
+    // Mode 3, same baud rate generator as mode 1, SM2 set on nodes until addressed
+    SCON = (SCON & 0x03) | 0xD0 | (mpFilter ? 0x20 : 0x00);
+    EA = ea;
+}
+
+/*
+ *@fn        -   serialTxAddress
+ *
+ *@brief     -   Function to send an address byte with the ninth bit (TB8) set
+ *
+ *@param[1]  -   Destination node address or SERIAL_MP_BROADCAST
+ *
+ *return     -   void
+ */
+void serialTxAddress(uint8_t address)
+{
+#ifdef SERIAL_USE_INTERRUPT
+    // TB8 belongs to the byte in SBUF, so the queued data must be out first
+    while (txBusy)
+    {
+        IDLE_POLL();
+    }
+    ES = 0;
+    TB8 = 1;
+    SBUF = address;
+    txBusy = 1; // the ISR clears TB8 before it loads the next data byte
+    ES = 1;
+#else
+    TB8 = 1;
+    SBUF = address;
+    while (!TI);
+    TI = 0;
+    TB8 = 0;
+#endif
+}
+
+/*
+ *@fn        -   serialRxAccept
+ *
+ *@brief     -   Function to sort a received byte in multiprocessor mode, address bytes set
+ *               SM2 so only frames for this node get through
+ *
+ *@param[1]  -   Received byte
+ *
+ *return     -   uint8_t, 1 for a data byte to pass on, 0 for an address byte
+ */
+static uint8_t serialRxAccept(uint8_t c)
+{
+    if (!mpNode || !RB8)
+    {
+        return 1;
+    }
+
+    if (mpFilter)
+    {
+        SM2 = (c != mpAddress && c != SERIAL_MP_BROADCAST);
+    }
+
+    return 0;
+}
+
+/*
+ *@fn        -   serialBaudActual
+ *
+ *@brief     -   Function to get the baud rate the configured generator really produces
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint32_t
+ */
+uint32_t serialBaudActual(void)
+{
+    if (baudTimer == T2)
+    {
+        return (CLOCK_SOURCE / 32UL) / (65536UL - baudReload);
+    }
+
+    return (CLOCK_SOURCE / (baudSmod ? 192UL : 384UL)) / (256 - (baudReload & 0xFF));
+}
+
+/*
+ *@fn        -   serialBaudError
+ *
+ *@brief     -   Function to get the error of the configured baud rate against a requested one
+ *
+ *@param[1]  -   Requested baud rate
+ *
+ *return     -   int16_t, in 0.01% units, positive when the UART runs fast
+ */
+int16_t serialBaudError(uint32_t baud)
+{
+    uint32_t actual = serialBaudActual();
+    int32_t diff = (int32_t)actual - (int32_t)baud;
+
+    return (int16_t)((diff * 10000L) / (int32_t)baud);
 }
 
 /*
@@ -42,9 +298,26 @@ void serialInit(uint32_t baud)
  */
 void serialTx(uint8_t buffer)
 {
+#ifdef SERIAL_USE_INTERRUPT
+    while ((uint8_t)(txHead - txTail) == SERIAL_TX_BUFFER_SIZE) // Wait only when the buffer is full
+    {
+        IDLE_POLL();
+    }
+    txBuffer[txHead & SERIAL_TX_MASK] = buffer;
+
+    ES = 0;
+    txHead++;
+    if (!txBusy)
+    {
+        txBusy = 1;
+        TI = 1; // Kick the ISR to load SBUF
+    }
+    ES = 1;
+#else
     SBUF = buffer;
     while (!TI);
     TI = 0;
+#endif
 }
 
 /*
@@ -58,15 +331,31 @@ void serialTx(uint8_t buffer)
  */
 uint8_t serialRx(void)
 {
-    while (!RI);
-    RI = 0;
-    return SBUF;
+#ifdef SERIAL_USE_INTERRUPT
+    uint8_t c;
+    while (rxHead == rxTail)
+    {
+        IDLE_POLL();
+    }
+    c = rxBuffer[rxTail & SERIAL_RX_MASK];
+    rxTail++;
+    return c;
+#else
+    uint8_t c;
+    do
+    {
+        while (!RI);
+        RI = 0;
+        c = SBUF;
+    } while (!serialRxAccept(c));
+    return c;
+#endif
 }
 
 /*
  *@fn        -   serialPrint
  *
- *@brief     -   Function to transmit the data string
+ *@brief     -   Function to transmit the formatted data string, conversions as in formatPrint
  *
  *@param[1]  -   Buffer reference for transmitting
  *@param[2]  -   For multiple parameters
@@ -77,45 +366,7 @@ void serialPrint(uint8_t *buffer, ...)
 {
     va_list args;
     va_start(args, buffer);
-
-    for (const uint8_t *p = buffer; *p != '\0'; p++)
-    {
-        if (*p == '%')
-        {
-            p++;
-            switch (*p)
-            {
-                case 'd': {
-                    int i = va_arg(args, int);
-                    char temp[10];
-                    intToStr(i, temp);
-                    serialWrite((uint8_t *)temp);
-                    break;
-                }
-
-                case 'c': {
-                    char c = (char)va_arg(args, int); // char promoted to int
-                    serialTx((uint8_t)c);
-                    break;
-                }
-
-                case 's': {
-                    char *str = va_arg(args, char *);
-                    serialWrite((uint8_t *)str);
-                    break;
-                }
-
-                default:
-                    serialWrite((uint8_t *)"Error finding the format specifier");
-                    break;
-            }
-        }
-        else
-        {
-            serialTx(*p);
-        }
-    }
-
+    formatPrintV(serialTx, (const char *)buffer, args);
     va_end(args);
 }
 
@@ -161,40 +412,125 @@ void serialRead(uint8_t *buffer, uint16_t maxLen)
     buffer[i] = '\0'; // Null-terminate the string
 }
 
+/*
+ *@fn        -   serialTxAvailable
+ *
+ *@brief     -   Function to get the number of bytes serialTx can take without blocking
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t
+ */
+uint8_t serialTxAvailable(void)
+{
+#ifdef SERIAL_USE_INTERRUPT
+    return SERIAL_TX_BUFFER_SIZE - (uint8_t)(txHead - txTail);
+#else
+    return 1; // Polled mode always takes the byte, serialTx waits for it to shift out
+#endif
+}
 
 /*
- *@fn        -   intToStr
+ *@fn        -   serialRxAvailable
  *
- *@brief     -   Convert an integer to a string
+ *@brief     -   Function to get the number of received bytes waiting to be read
  *
- *@param[1]  -   Integer to convert
- *@param[2]  -   Buffer to store the resulting string
+ *@param[1]  -   void
  *
- *return     -   void
+ *return     -   uint8_t
  */
-static void intToStr(int num, char *str)
+uint8_t serialRxAvailable(void)
 {
-    char temp[10];
-    int i = 0, j;
+#ifdef SERIAL_USE_INTERRUPT
+    return (uint8_t)(rxHead - rxTail);
+#else
+    return RI ? 1 : 0;
+#endif
+}
 
-    // Handle 0 explicitly
-    if (num == 0)
+/*
+ *@fn        -   serialTryRead
+ *
+ *@brief     -   Function to read 1 byte of data if one is available, never blocks
+ *
+ *@param[1]  -   Reference to store the received byte
+ *
+ *return     -   uint8_t, 1 if a byte was read else 0
+ */
+uint8_t serialTryRead(uint8_t *buf)
+{
+#ifdef SERIAL_USE_INTERRUPT
+    if (rxHead == rxTail)
     {
-        str[i++] = '0';
-        str[i] = '\0';
-        return;
+        return 0;
     }
+    *buf = rxBuffer[rxTail & SERIAL_RX_MASK];
+    rxTail++;
+    return 1;
+#else
+    uint8_t c;
 
-    // Process individual digits
-    while (num != 0)
+    if (!RI)
     {
-        temp[i++] = (num % 10) + '0';
-        num /= 10;
+        return 0;
     }
+    RI = 0;
+    c = SBUF;
+    if (!serialRxAccept(c))
+    {
+        return 0;
+    }
+    *buf = c;
+    return 1;
+#endif
+}
 
-    // Append digits in reverse order
-    for (j = i - 1; j >= 0; j--)
-        str[i - j - 1] = temp[j];
+#ifdef SERIAL_USE_INTERRUPT
+/*
+ *@fn        -   serialIsr
+ *
+ *@brief     -   UART interrupt service routine, moves bytes between SBUF and the ring buffers
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+void serialIsr(void) __interrupt(SERIAL_VECTOR)
+{
+    uint8_t c;
+
+    if (RI)
+    {
+        RI = 0;
+        c = SBUF;
+        if (serialRxAccept(c))
+        {
+#ifdef SERIAL_RX_HOOK
+            SERIAL_RX_HOOK(c);
+#else
+            if ((uint8_t)(rxHead - rxTail) != SERIAL_RX_BUFFER_SIZE)
+            {
+                rxBuffer[rxHead & SERIAL_RX_MASK] = c;
+                rxHead++;
+            }
+            // else the byte is dropped, the buffer is full
+#endif
+        }
+    }
 
-    str[i] = '\0';
+    if (TI)
+    {
+        TI = 0;
+        if (txHead != txTail)
+        {
+            TB8 = 0; // data byte, after a serialTxAddress
+            SBUF = txBuffer[txTail & SERIAL_TX_MASK];
+            txTail++;
+        }
+        else
+        {
+            txBusy = 0;
+        }
+    }
 }
+#endif
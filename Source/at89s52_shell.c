@@ -0,0 +1,364 @@
+/*
+ * at89s52_shell.c
+ * Description: This file contains the command shell. Lines are tokenized as the characters
+ *              arrive, string arguments stay in the line buffer and numbers never touch it.
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for function declarations
+#include "at89s52_shell.h"
+// Library for the UART shellPoll reads from
+#include "at89s52_serial.h"
+// Standard library for strcmp
+#include <string.h>
+
+static const shellCommand_t *commands;
+static uint8_t commandCount;
+
+static SHELL_BUFFER_SPACE char line[SHELL_LINE_SIZE];
+static uint8_t lineLen;
+static uint8_t tokenStart;
+static const shellCommand_t *command;   // 0 while the name is being read
+static shellArg_t args[SHELL_MAX_ARGS];
+static uint8_t argc;
+static uint8_t status;                  // first error of the line, SHELL_PENDING if none
+static uint16_t value;                  // number being converted
+static uint8_t digits;
+static char kind;                       // schema letter of the current argument
+static __bit inToken;
+static __bit negative;
+static __bit hex;
+static __bit lastCr;                    // '\n' right after '\r' is the same line end
+
+/*
+ *@fn        -   shellReset
+ *
+ *@brief     -   Function to clear the state for the next line
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void shellReset(void)
+{
+    lineLen = 0;
+    command = 0;
+    argc = 0;
+    status = SHELL_PENDING;
+    inToken = 0;
+}
+
+/*
+ *@fn        -   shellInit
+ *
+ *@brief     -   Function to set the command table and clear the line state
+ *
+ *@param[1]  -   Command table sorted by name, usually in __code
+ *@param[2]  -   Number of commands
+ *
+ *return     -   void
+ */
+void shellInit(const shellCommand_t *table, uint8_t count)
+{
+    commands = table;
+    commandCount = count;
+    shellReset();
+}
+
+/*
+ *@fn        -   shellFind
+ *
+ *@brief     -   Function to binary search the command table
+ *
+ *@param[1]  -   Command name
+ *
+ *return     -   const shellCommand_t *, 0 if not found
+ */
+static const shellCommand_t *shellFind(const char *name)
+{
+    uint8_t low = 0;
+    uint8_t high = commandCount;
+    uint8_t mid;
+    int cmp;
+
+    while (low < high)
+    {
+        mid = (low + high) >> 1;
+        cmp = strcmp(name, commands[mid].name);
+        if (cmp == 0)
+        {
+            return &commands[mid];
+        }
+        if (cmp < 0)
+        {
+            high = mid;
+        }
+        else
+        {
+            low = mid + 1;
+        }
+    }
+
+    return 0;
+}
+
+/*
+ *@fn        -   shellStore
+ *
+ *@brief     -   Function to append a character of the name or a string argument
+ *
+ *@param[1]  -   Character
+ *
+ *return     -   void
+ */
+static void shellStore(char c)
+{
+    if (lineLen < SHELL_LINE_SIZE)
+    {
+        line[lineLen++] = c;
+    }
+    else
+    {
+        status = SHELL_TOO_LONG;
+    }
+}
+
+/*
+ *@fn        -   shellDigit
+ *
+ *@brief     -   Function to add a character to the number being converted
+ *
+ *@param[1]  -   Character
+ *
+ *return     -   void
+ */
+static void shellDigit(char c)
+{
+    uint8_t d;
+
+    if (c == '-' && kind == 'i' && digits == 0 && !negative)
+    {
+        negative = 1;
+        return;
+    }
+    if ((c == 'x' || c == 'X') && kind == 'u' && digits == 1 && value == 0 && !hex)
+    {
+        hex = 1;
+        digits = 0;
+        return;
+    }
+
+    if (c >= '0' && c <= '9')
+    {
+        d = c - '0';
+    }
+    else if (hex && (c | 0x20) >= 'a' && (c | 0x20) <= 'f')
+    {
+        d = (c | 0x20) - 'a' + 10;
+    }
+    else
+    {
+        status = SHELL_BAD_ARGS;
+        return;
+    }
+
+    // Overflow checks without a division
+    if (hex)
+    {
+        if (value & 0xF000)
+        {
+            status = SHELL_BAD_ARGS;
+            return;
+        }
+        value = (value << 4) | d;
+    }
+    else
+    {
+        if (value > 6553 || (value == 6553 && d > 5))
+        {
+            status = SHELL_BAD_ARGS;
+            return;
+        }
+        value = value * 10 + d;
+    }
+    digits++;
+}
+
+/*
+ *@fn        -   shellTokenStart
+ *
+ *@brief     -   Function to open a token, arguments take their schema letter
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void shellTokenStart(void)
+{
+    inToken = 1;
+    tokenStart = lineLen;
+    if (command == 0)
+    {
+        return;
+    }
+
+    kind = command->schema[argc];
+    if (kind == '\0' || argc == SHELL_MAX_ARGS)
+    {
+        status = SHELL_BAD_ARGS;
+    }
+    value = 0;
+    digits = 0;
+    negative = 0;
+    hex = 0;
+}
+
+/*
+ *@fn        -   shellTokenEnd
+ *
+ *@brief     -   Function to close a token, looks up the command or stores the argument
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void shellTokenEnd(void)
+{
+    inToken = 0;
+    if (command == 0 || kind == 's')
+    {
+        shellStore('\0');
+    }
+    if (status != SHELL_PENDING)
+    {
+        return;
+    }
+
+    if (command == 0)
+    {
+        command = shellFind(line);
+        if (command == 0)
+        {
+            status = SHELL_UNKNOWN;
+        }
+        lineLen = 0; // the name is done with, string arguments reuse the buffer
+        return;
+    }
+
+    if (kind == 's')
+    {
+        args[argc].s = &line[tokenStart];
+    }
+    else
+    {
+        if (digits == 0 || (kind == 'i' && value > (negative ? 32768U : 32767U)))
+        {
+            status = SHELL_BAD_ARGS;
+            return;
+        }
+        args[argc].u = negative ? (uint16_t)(0 - value) : value;
+    }
+    argc++;
+}
+
+/*
+ *@fn        -   shellInput
+ *
+ *@brief     -   Function to feed one received character
+ *
+ *@param[1]  -   Received character
+ *
+ *return     -   uint8_t, SHELL_PENDING until a line ends, then its result
+ */
+uint8_t shellInput(char c)
+{
+    uint8_t result;
+
+    if (c == '\n' && lastCr)
+    {
+        lastCr = 0;
+        return SHELL_PENDING;
+    }
+    lastCr = (c == '\r');
+
+    if (c == '\r' || c == '\n')
+    {
+        if (inToken)
+        {
+            shellTokenEnd();
+        }
+
+        result = status;
+        if (result == SHELL_PENDING)
+        {
+            if (command == 0)
+            {
+                result = SHELL_EMPTY;
+            }
+            else if (command->schema[argc] != '\0')
+            {
+                result = SHELL_BAD_ARGS;
+            }
+            else
+            {
+                command->handler(args);
+                result = SHELL_OK;
+            }
+        }
+        shellReset();
+        return result;
+    }
+
+    if (c == ' ' || c == '\t')
+    {
+        if (inToken)
+        {
+            shellTokenEnd();
+        }
+        return SHELL_PENDING;
+    }
+
+    if (!inToken)
+    {
+        shellTokenStart();
+    }
+    if (status != SHELL_PENDING)
+    {
+        return SHELL_PENDING; // skip the rest of a bad line
+    }
+
+    if (command == 0 || kind == 's')
+    {
+        shellStore(c);
+    }
+    else
+    {
+        shellDigit(c);
+    }
+
+    return SHELL_PENDING;
+}
+
+/*
+ *@fn        -   shellPoll
+ *
+ *@brief     -   Function to feed the shell whatever the UART has received, never blocks
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t, as shellInput
+ */
+uint8_t shellPoll(void)
+{
+    uint8_t c;
+    uint8_t result = SHELL_PENDING;
+
+    while (result == SHELL_PENDING && serialTryRead(&c))
+    {
+        result = shellInput((char)c);
+    }
+
+    return result;
+}
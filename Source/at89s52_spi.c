@@ -0,0 +1,500 @@
+/*
+ * at89s52_spi.c
+ * Description: This file contains the bit-banged SPI master. Each mode has its own fully
+ *              unrolled byte shift that rotates the data through the carry flag, one RLC per
+ *              bit moves the next bit out to C and the received bit in.
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for function declarations
+#include "at89s52_spi.h"
+
+/* Pin symbols for the assembler, SDCC names an __sbit P1_5 _P1_5 */
+#define SPI_ASM_PIN(pin)    SPI_ASM_PIN_(pin)
+#define SPI_ASM_PIN_(pin)   _##pin
+#define SPI_ASM_MOSI        SPI_ASM_PIN(SPI_MOSI)
+#define SPI_ASM_MISO        SPI_ASM_PIN(SPI_MISO)
+#define SPI_ASM_SCK         SPI_ASM_PIN(SPI_SCK)
+
+/* Byte shift of the selected mode, called through a pointer so the bursts need no mode test */
+static uint8_t (*spiXfer)(uint8_t out);
+
+#ifdef AT89S52_HOST
+
+/*
+ *@fn        -   spiShift
+ *
+ *@brief     -   Function to shift one byte in C, same edges and bit order as the assembly,
+ *               for host builds against the emulated pins
+ *
+ *@param[1]  -   Byte to send
+ *@param[2]  -   SPI_MODE0 to SPI_MODE3
+ *
+ *return     -   uint8_t, received byte
+ */
+static uint8_t spiShift(uint8_t out, uint8_t mode)
+{
+    uint8_t cpol = (mode & 0x02) ? 1 : 0;
+    uint8_t cpha = mode & 0x01;
+    uint8_t in = 0;
+    uint8_t i;
+
+    for (i = 0; i < 8; i++)
+    {
+        if (cpha)
+        {
+            SPI_SCK = !cpol; // leading edge, data changes
+        }
+        SPI_MOSI = (out & 0x80) ? 1 : 0;
+        out <<= 1;
+        SPI_SCK = cpha ? cpol : !cpol; // sampling edge
+        in = (in << 1) | (SPI_MISO ? 1 : 0);
+        if (!cpha)
+        {
+            SPI_SCK = cpol;
+        }
+    }
+
+    return in;
+}
+
+/*
+ *@fn        -   spiXfer0
+ *
+ *@brief     -   Function to shift one byte in mode 0
+ *
+ *@param[1]  -   Byte to send
+ *
+ *return     -   uint8_t, received byte
+ */
+static uint8_t spiXfer0(uint8_t out)
+{
+    return spiShift(out, SPI_MODE0);
+}
+
+/*
+ *@fn        -   spiXfer1
+ *
+ *@brief     -   Function to shift one byte in mode 1
+ *
+ *@param[1]  -   Byte to send
+ *
+ *return     -   uint8_t, received byte
+ */
+static uint8_t spiXfer1(uint8_t out)
+{
+    return spiShift(out, SPI_MODE1);
+}
+
+/*
+ *@fn        -   spiXfer2
+ *
+ *@brief     -   Function to shift one byte in mode 2
+ *
+ *@param[1]  -   Byte to send
+ *
+ *return     -   uint8_t, received byte
+ */
+static uint8_t spiXfer2(uint8_t out)
+{
+    return spiShift(out, SPI_MODE2);
+}
+
+/*
+ *@fn        -   spiXfer3
+ *
+ *@brief     -   Function to shift one byte in mode 3
+ *
+ *@param[1]  -   Byte to send
+ *
+ *return     -   uint8_t, received byte
+ */
+static uint8_t spiXfer3(uint8_t out)
+{
+    return spiShift(out, SPI_MODE3);
+}
+
+#else
+
+/*
+ * Every mode: RLC puts the MSB in C, then per bit MOSI takes C, the clock makes its two
+ * edges, C takes MISO and RLC shifts it in while the next bit moves out. Per bit MOV bit,C
+ * is 2 cycles and SETB, CLR, MOV C,bit, RLC are 1 each, 53 cycles for the byte with RET.
+ */
+
+/*
+ *@fn        -   spiXfer0
+ *
+ *@brief     -   Function to shift one byte in mode 0, CPOL 0, CPHA 0: MOSI before the rising edge, MISO sampled on it
+ *
+ *@param[1]  -   Byte to send, in DPL
+ *
+ *return     -   uint8_t, received byte in DPL
+ */
+static uint8_t spiXfer0(uint8_t out) __naked
+{
+    (void)out;
+    __asm
+        mov  a, dpl
+        rlc  a
+        ; bit 7
+        mov  SPI_ASM_MOSI, c
+        setb SPI_ASM_SCK
+        mov  c, SPI_ASM_MISO
+        clr  SPI_ASM_SCK
+        rlc  a
+        ; bit 6
+        mov  SPI_ASM_MOSI, c
+        setb SPI_ASM_SCK
+        mov  c, SPI_ASM_MISO
+        clr  SPI_ASM_SCK
+        rlc  a
+        ; bit 5
+        mov  SPI_ASM_MOSI, c
+        setb SPI_ASM_SCK
+        mov  c, SPI_ASM_MISO
+        clr  SPI_ASM_SCK
+        rlc  a
+        ; bit 4
+        mov  SPI_ASM_MOSI, c
+        setb SPI_ASM_SCK
+        mov  c, SPI_ASM_MISO
+        clr  SPI_ASM_SCK
+        rlc  a
+        ; bit 3
+        mov  SPI_ASM_MOSI, c
+        setb SPI_ASM_SCK
+        mov  c, SPI_ASM_MISO
+        clr  SPI_ASM_SCK
+        rlc  a
+        ; bit 2
+        mov  SPI_ASM_MOSI, c
+        setb SPI_ASM_SCK
+        mov  c, SPI_ASM_MISO
+        clr  SPI_ASM_SCK
+        rlc  a
+        ; bit 1
+        mov  SPI_ASM_MOSI, c
+        setb SPI_ASM_SCK
+        mov  c, SPI_ASM_MISO
+        clr  SPI_ASM_SCK
+        rlc  a
+        ; bit 0
+        mov  SPI_ASM_MOSI, c
+        setb SPI_ASM_SCK
+        mov  c, SPI_ASM_MISO
+        clr  SPI_ASM_SCK
+        rlc  a
+        mov  dpl, a
+        ret
+    __endasm;
+}
+
+/*
+ *@fn        -   spiXfer1
+ *
+ *@brief     -   Function to shift one byte in mode 1, CPOL 0, CPHA 1: MOSI on the rising edge, MISO sampled on the falling edge
+ *
+ *@param[1]  -   Byte to send, in DPL
+ *
+ *return     -   uint8_t, received byte in DPL
+ */
+static uint8_t spiXfer1(uint8_t out) __naked
+{
+    (void)out;
+    __asm
+        mov  a, dpl
+        rlc  a
+        ; bit 7
+        setb SPI_ASM_SCK
+        mov  SPI_ASM_MOSI, c
+        clr  SPI_ASM_SCK
+        mov  c, SPI_ASM_MISO
+        rlc  a
+        ; bit 6
+        setb SPI_ASM_SCK
+        mov  SPI_ASM_MOSI, c
+        clr  SPI_ASM_SCK
+        mov  c, SPI_ASM_MISO
+        rlc  a
+        ; bit 5
+        setb SPI_ASM_SCK
+        mov  SPI_ASM_MOSI, c
+        clr  SPI_ASM_SCK
+        mov  c, SPI_ASM_MISO
+        rlc  a
+        ; bit 4
+        setb SPI_ASM_SCK
+        mov  SPI_ASM_MOSI, c
+        clr  SPI_ASM_SCK
+        mov  c, SPI_ASM_MISO
+        rlc  a
+        ; bit 3
+        setb SPI_ASM_SCK
+        mov  SPI_ASM_MOSI, c
+        clr  SPI_ASM_SCK
+        mov  c, SPI_ASM_MISO
+        rlc  a
+        ; bit 2
+        setb SPI_ASM_SCK
+        mov  SPI_ASM_MOSI, c
+        clr  SPI_ASM_SCK
+        mov  c, SPI_ASM_MISO
+        rlc  a
+        ; bit 1
+        setb SPI_ASM_SCK
+        mov  SPI_ASM_MOSI, c
+        clr  SPI_ASM_SCK
+        mov  c, SPI_ASM_MISO
+        rlc  a
+        ; bit 0
+        setb SPI_ASM_SCK
+        mov  SPI_ASM_MOSI, c
+        clr  SPI_ASM_SCK
+        mov  c, SPI_ASM_MISO
+        rlc  a
+        mov  dpl, a
+        ret
+    __endasm;
+}
+
+/*
+ *@fn        -   spiXfer2
+ *
+ *@brief     -   Function to shift one byte in mode 2, CPOL 1, CPHA 0: MOSI before the falling edge, MISO sampled on it
+ *
+ *@param[1]  -   Byte to send, in DPL
+ *
+ *return     -   uint8_t, received byte in DPL
+ */
+static uint8_t spiXfer2(uint8_t out) __naked
+{
+    (void)out;
+    __asm
+        mov  a, dpl
+        rlc  a
+        ; bit 7
+        mov  SPI_ASM_MOSI, c
+        clr  SPI_ASM_SCK
+        mov  c, SPI_ASM_MISO
+        setb SPI_ASM_SCK
+        rlc  a
+        ; bit 6
+        mov  SPI_ASM_MOSI, c
+        clr  SPI_ASM_SCK
+        mov  c, SPI_ASM_MISO
+        setb SPI_ASM_SCK
+        rlc  a
+        ; bit 5
+        mov  SPI_ASM_MOSI, c
+        clr  SPI_ASM_SCK
+        mov  c, SPI_ASM_MISO
+        setb SPI_ASM_SCK
+        rlc  a
+        ; bit 4
+        mov  SPI_ASM_MOSI, c
+        clr  SPI_ASM_SCK
+        mov  c, SPI_ASM_MISO
+        setb SPI_ASM_SCK
+        rlc  a
+        ; bit 3
+        mov  SPI_ASM_MOSI, c
+        clr  SPI_ASM_SCK
+        mov  c, SPI_ASM_MISO
+        setb SPI_ASM_SCK
+        rlc  a
+        ; bit 2
+        mov  SPI_ASM_MOSI, c
+        clr  SPI_ASM_SCK
+        mov  c, SPI_ASM_MISO
+        setb SPI_ASM_SCK
+        rlc  a
+        ; bit 1
+        mov  SPI_ASM_MOSI, c
+        clr  SPI_ASM_SCK
+        mov  c, SPI_ASM_MISO
+        setb SPI_ASM_SCK
+        rlc  a
+        ; bit 0
+        mov  SPI_ASM_MOSI, c
+        clr  SPI_ASM_SCK
+        mov  c, SPI_ASM_MISO
+        setb SPI_ASM_SCK
+        rlc  a
+        mov  dpl, a
+        ret
+    __endasm;
+}
+
+/*
+ *@fn        -   spiXfer3
+ *
+ *@brief     -   Function to shift one byte in mode 3, CPOL 1, CPHA 1: MOSI on the falling edge, MISO sampled on the rising edge
+ *
+ *@param[1]  -   Byte to send, in DPL
+ *
+ *return     -   uint8_t, received byte in DPL
+ */
+static uint8_t spiXfer3(uint8_t out) __naked
+{
+    (void)out;
+    __asm
+        mov  a, dpl
+        rlc  a
+        ; bit 7
+        clr  SPI_ASM_SCK
+        mov  SPI_ASM_MOSI, c
+        setb SPI_ASM_SCK
+        mov  c, SPI_ASM_MISO
+        rlc  a
+        ; bit 6
+        clr  SPI_ASM_SCK
+        mov  SPI_ASM_MOSI, c
+        setb SPI_ASM_SCK
+        mov  c, SPI_ASM_MISO
+        rlc  a
+        ; bit 5
+        clr  SPI_ASM_SCK
+        mov  SPI_ASM_MOSI, c
+        setb SPI_ASM_SCK
+        mov  c, SPI_ASM_MISO
+        rlc  a
+        ; bit 4
+        clr  SPI_ASM_SCK
+        mov  SPI_ASM_MOSI, c
+        setb SPI_ASM_SCK
+        mov  c, SPI_ASM_MISO
+        rlc  a
+        ; bit 3
+        clr  SPI_ASM_SCK
+        mov  SPI_ASM_MOSI, c
+        setb SPI_ASM_SCK
+        mov  c, SPI_ASM_MISO
+        rlc  a
+        ; bit 2
+        clr  SPI_ASM_SCK
+        mov  SPI_ASM_MOSI, c
+        setb SPI_ASM_SCK
+        mov  c, SPI_ASM_MISO
+        rlc  a
+        ; bit 1
+        clr  SPI_ASM_SCK
+        mov  SPI_ASM_MOSI, c
+        setb SPI_ASM_SCK
+        mov  c, SPI_ASM_MISO
+        rlc  a
+        ; bit 0
+        clr  SPI_ASM_SCK
+        mov  SPI_ASM_MOSI, c
+        setb SPI_ASM_SCK
+        mov  c, SPI_ASM_MISO
+        rlc  a
+        mov  dpl, a
+        ret
+    __endasm;
+}
+
+#endif // AT89S52_HOST
+
+/*
+ *@fn        -   spiInit
+ *
+ *@brief     -   Function to set the SPI mode and put the pins in their idle state
+ *
+ *@param[1]  -   SPI_MODE0 to SPI_MODE3
+ *
+ *return     -   void
+ */
+void spiInit(uint8_t mode)
+{
+    switch (mode)
+    {
+    case SPI_MODE1:
+        spiXfer = spiXfer1;
+        break;
+    case SPI_MODE2:
+        spiXfer = spiXfer2;
+        break;
+    case SPI_MODE3:
+        spiXfer = spiXfer3;
+        break;
+    default:
+        spiXfer = spiXfer0;
+        break;
+    }
+
+    SPI_SCK = (mode & 0x02) ? 1 : 0; // CPOL
+    SPI_MOSI = 1;
+    SPI_MISO = 1; // Latch 1 makes the pin an input
+}
+
+/*
+ *@fn        -   spiTransfer
+ *
+ *@brief     -   Function to send one byte and return the byte clocked in at the same time
+ *
+ *@param[1]  -   Byte to send
+ *
+ *return     -   uint8_t
+ */
+uint8_t spiTransfer(uint8_t out)
+{
+    return spiXfer(out);
+}
+
+/*
+ *@fn        -   spiWrite
+ *
+ *@brief     -   Function to send a buffer, the received bytes are discarded
+ *
+ *@param[1]  -   Data reference
+ *@param[2]  -   Number of bytes
+ *
+ *return     -   void
+ */
+void spiWrite(const uint8_t *buf, uint16_t len)
+{
+    while (len--)
+    {
+        spiXfer(*buf++);
+    }
+}
+
+/*
+ *@fn        -   spiRead
+ *
+ *@brief     -   Function to read into a buffer, sends 0xFF for every byte
+ *
+ *@param[1]  -   Buffer reference
+ *@param[2]  -   Number of bytes
+ *
+ *return     -   void
+ */
+void spiRead(uint8_t *buf, uint16_t len)
+{
+    while (len--)
+    {
+        *buf++ = spiXfer(0xFF);
+    }
+}
+
+/*
+ *@fn        -   spiExchange
+ *
+ *@brief     -   Function to send one buffer and receive into another in the same transfer
+ *
+ *@param[1]  -   Data to send
+ *@param[2]  -   Buffer for the received data
+ *@param[3]  -   Number of bytes
+ *
+ *return     -   void
+ */
+void spiExchange(const uint8_t *tx, uint8_t *rx, uint16_t len)
+{
+    while (len--)
+    {
+        *rx++ = spiXfer(*tx++);
+    }
+}
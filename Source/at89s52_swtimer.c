@@ -0,0 +1,299 @@
+/*
+ * at89s52_swtimer.c
+ * Description: This file contains a hashed timer wheel of software timers driven by the tick ISR.
+ *              A timer due in d ticks sits in slot (cursor + d) % SWTIMER_SLOTS with
+ *              (d - 1) / SWTIMER_SLOTS extra rounds. Slots are doubly linked lists of pool
+ *              indexes, so start and stop are O(1) and each tick only walks the current slot.
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for function declarations
+#include "at89s52_swtimer.h"
+
+#define SWTIMER_MASK    (SWTIMER_SLOTS - 1)
+
+/* Timer states */
+#define STATE_FREE      0
+#define STATE_IDLE      1
+#define STATE_ARMED     2
+#define STATE_EXPIRED   3   // off the wheel, waiting for its callback in this tick
+
+typedef char swTimerSlotCheck[(SWTIMER_SLOTS & SWTIMER_MASK) == 0 ? 1 : -1];
+typedef char swTimerMaxCheck[SWTIMER_MAX < SWTIMER_NONE ? 1 : -1];
+
+typedef struct
+{
+    uint8_t next;               // next timer in the slot or free list
+    uint8_t prev;               // previous timer in the slot
+    uint8_t expiredNext;        // next timer expired in this tick, callbacks never touch it
+    uint8_t slot;
+    uint8_t state;
+    uint16_t rounds;            // full wheel turns left before expiry
+    uint16_t period;            // reload for periodic timers, 0 for one-shot
+    swTimerCallback_t callback;
+} swTimer_t;
+
+static SWTIMER_SPACE swTimer_t timers[SWTIMER_MAX];
+static uint8_t slotHead[SWTIMER_SLOTS];
+static uint8_t freeHead;
+static uint8_t cursor;
+
+/*
+ *@fn        -   wheelInsert
+ *
+ *@brief     -   Function to link a timer into the slot due after a number of ticks
+ *
+ *@param[1]  -   Timer id
+ *@param[2]  -   Ticks until expiry, at least 1
+ *
+ *return     -   void
+ */
+static void wheelInsert(uint8_t id, uint16_t ticks) __reentrant
+{
+    uint8_t slot = (cursor + (uint8_t)ticks) & SWTIMER_MASK;
+    SWTIMER_SPACE swTimer_t *t = &timers[id];
+
+    t->rounds = (ticks - 1) / SWTIMER_SLOTS;
+    t->slot = slot;
+    t->state = STATE_ARMED;
+    t->prev = SWTIMER_NONE;
+    t->next = slotHead[slot];
+    if (slotHead[slot] != SWTIMER_NONE)
+    {
+        timers[slotHead[slot]].prev = id;
+    }
+    slotHead[slot] = id;
+}
+
+/*
+ *@fn        -   wheelRemove
+ *
+ *@brief     -   Function to unlink an armed timer from its slot
+ *
+ *@param[1]  -   Timer id
+ *
+ *return     -   void
+ */
+static void wheelRemove(uint8_t id) __reentrant
+{
+    SWTIMER_SPACE swTimer_t *t = &timers[id];
+
+    if (t->prev != SWTIMER_NONE)
+    {
+        timers[t->prev].next = t->next;
+    }
+    else
+    {
+        slotHead[t->slot] = t->next;
+    }
+
+    if (t->next != SWTIMER_NONE)
+    {
+        timers[t->next].prev = t->prev;
+    }
+}
+
+/*
+ *@fn        -   swTimerInit
+ *
+ *@brief     -   Function to clear the timer pool and attach the wheel to the tick
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t, 0 if the tick has no free hook
+ */
+uint8_t swTimerInit(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < SWTIMER_SLOTS; i++)
+    {
+        slotHead[i] = SWTIMER_NONE;
+    }
+
+    for (i = 0; i < SWTIMER_MAX; i++)
+    {
+        timers[i].state = STATE_FREE;
+        timers[i].next = i + 1;
+    }
+    timers[SWTIMER_MAX - 1].next = SWTIMER_NONE;
+    freeHead = 0;
+    cursor = 0;
+
+    return tickAttach(swTimerTick);
+}
+
+/*
+ *@fn        -   swTimerCreate
+ *
+ *@brief     -   Function to take a timer from the pool
+ *
+ *@param[1]  -   Function to call when the timer expires
+ *
+ *return     -   uint8_t, timer id or SWTIMER_NONE
+ */
+uint8_t swTimerCreate(swTimerCallback_t callback)
+{
+    uint8_t id;
+    uint8_t ea = EA;
+
+    EA = 0;
+    id = freeHead;
+    if (id != SWTIMER_NONE)
+    {
+        freeHead = timers[id].next;
+        timers[id].state = STATE_IDLE;
+        timers[id].callback = callback;
+    }
+    EA = ea;
+
+    return id;
+}
+
+/*
+ *@fn        -   swTimerDelete
+ *
+ *@brief     -   Function to stop a timer and return it to the pool
+ *
+ *@param[1]  -   Timer id
+ *
+ *return     -   void
+ */
+void swTimerDelete(uint8_t id)
+{
+    uint8_t ea = EA;
+
+    swTimerStop(id);
+
+    EA = 0;
+    timers[id].state = STATE_FREE;
+    timers[id].next = freeHead;
+    freeHead = id;
+    EA = ea;
+}
+
+/*
+ *@fn        -   swTimerStart
+ *
+ *@brief     -   Function to arm a timer, restarts it if it is already running
+ *
+ *@param[1]  -   Timer id
+ *@param[2]  -   Ticks until the first expiry, 0 is treated as 1
+ *@param[3]  -   Ticks between later expiries, 0 for a one-shot timer
+ *
+ *return     -   void
+ */
+void swTimerStart(uint8_t id, uint16_t ticks, uint16_t period) __reentrant
+{
+    uint8_t ea = EA;
+
+    EA = 0;
+    if (timers[id].state == STATE_ARMED)
+    {
+        wheelRemove(id);
+    }
+    timers[id].period = period;
+    wheelInsert(id, ticks ? ticks : 1);
+    EA = ea;
+}
+
+/*
+ *@fn        -   swTimerStop
+ *
+ *@brief     -   Function to disarm a timer
+ *
+ *@param[1]  -   Timer id
+ *
+ *return     -   void
+ */
+void swTimerStop(uint8_t id) __reentrant
+{
+    uint8_t ea = EA;
+
+    EA = 0;
+    if (timers[id].state == STATE_ARMED)
+    {
+        wheelRemove(id);
+    }
+    // An expired timer waiting for its callback is cancelled by leaving the expired state
+    if (timers[id].state != STATE_FREE)
+    {
+        timers[id].state = STATE_IDLE;
+    }
+    EA = ea;
+}
+
+/*
+ *@fn        -   swTimerActive
+ *
+ *@brief     -   Function to check whether a timer is armed
+ *
+ *@param[1]  -   Timer id
+ *
+ *return     -   uint8_t
+ */
+uint8_t swTimerActive(uint8_t id)
+{
+    return timers[id].state == STATE_ARMED;
+}
+
+/*
+ *@fn        -   swTimerTick
+ *
+ *@brief     -   Function to advance the wheel one slot, attached to the tick by swTimerInit
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+void swTimerTick(void)
+{
+    uint8_t id, next;
+    uint8_t expired = SWTIMER_NONE;
+
+    cursor = (cursor + 1) & SWTIMER_MASK;
+
+    // First pass: count down the slot and unlink what is due, no callbacks run yet
+    for (id = slotHead[cursor]; id != SWTIMER_NONE; id = next)
+    {
+        SWTIMER_SPACE swTimer_t *t = &timers[id];
+
+        next = t->next;
+        if (t->rounds)
+        {
+            t->rounds--;
+        }
+        else
+        {
+            wheelRemove(id);
+            t->state = STATE_EXPIRED;
+            t->expiredNext = expired;
+            expired = id;
+        }
+    }
+
+    // Second pass: re-arm periodic timers, then call back. A callback may start or stop any timer,
+    // which rewrites next but not expiredNext, so the rest of the list stays intact
+    for (id = expired; id != SWTIMER_NONE; id = next)
+    {
+        SWTIMER_SPACE swTimer_t *t = &timers[id];
+
+        next = t->expiredNext;
+        if (t->state != STATE_EXPIRED)
+        {
+            continue; // stopped by an earlier callback
+        }
+
+        if (t->period)
+        {
+            wheelInsert(id, t->period);
+        }
+        else
+        {
+            t->state = STATE_IDLE;
+        }
+        t->callback(id);
+    }
+}
@@ -0,0 +1,228 @@
+/*
+ * at89s52_tick.c
+ * Description: This file contains the free running system tick and the millis()/micros() timebase
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for function declarations
+#include "at89s52_tick.h"
+
+/* Machine cycles Timer 0 is stopped while the ISR re-arms it, added back to the reload */
+#ifndef TICK_T0_FIXUP
+#define TICK_T0_FIXUP 8
+#endif
+
+/* Microseconds per timer count scaled by 2^16 */
+#define TICK_US_SCALE ((12000UL * 65536UL) / (CLOCK_SOURCE / 1000UL))
+
+volatile uint32_t tickCount;
+#if TICK_PERIOD_US != 1000
+static volatile uint32_t msCount;
+static volatile uint16_t msFraction;
+#endif
+#if TICK_FRACTION != 0
+static uint16_t fractionSum;
+#endif
+static __bit tickEnabled;
+
+static tickHook_t hooks[TICK_MAX_HOOKS];
+static volatile uint8_t hookCount;
+
+/*
+ *@fn        -   tickInit
+ *
+ *@brief     -   Function to start the free running tick on TICK_TIMER and enable its interrupt
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+void tickInit(void)
+{
+    tickCount = 0;
+#if TICK_PERIOD_US != 1000
+    msCount = 0;
+    msFraction = 0;
+#endif
+#if TICK_FRACTION != 0
+    fractionSum = 0;
+#endif
+    tickEnabled = 1;
+
+    // Timer 2 auto-reloads from RCAP2 in hardware, Timer 0 is re-armed by tickIsr
+    timerInterruptConfig(TICK_TIMER, TICK_RELOAD, ENABLE);
+}
+
+/*
+ *@fn        -   tickRunning
+ *
+ *@brief     -   Function to check whether the tick has been started
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint8_t
+ */
+uint8_t tickRunning(void)
+{
+    return tickEnabled;
+}
+
+/*
+ *@fn        -   tickAttach
+ *
+ *@brief     -   Function to register a function the tick ISR calls on every tick
+ *
+ *@param[1]  -   Function to call, runs in interrupt context
+ *
+ *return     -   uint8_t, 0 if TICK_MAX_HOOKS are already registered
+ */
+uint8_t tickAttach(tickHook_t hook)
+{
+    if (hookCount == TICK_MAX_HOOKS)
+    {
+        return 0;
+    }
+
+    // Store the pointer before publishing the count so the ISR never calls an empty slot
+    hooks[hookCount] = hook;
+    hookCount++;
+    return 1;
+}
+
+/*
+ *@fn        -   millis
+ *
+ *@brief     -   Function to read the milliseconds elapsed since tickInit
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint32_t
+ */
+uint32_t millis(void)
+{
+    uint32_t ms;
+    uint8_t et = TICK_ET;
+
+    // A 32-bit copy takes several instructions, keep the ISR out while it is made. Restore
+    // TICK_ET instead of setting it, a call before tickInit must not enable the tick ISR
+    TICK_ET = 0;
+#if TICK_PERIOD_US == 1000
+    ms = tickCount;
+#else
+    ms = msCount;
+#endif
+    TICK_ET = et;
+
+    return ms;
+}
+
+/*
+ *@fn        -   micros
+ *
+ *@brief     -   Function to read the microseconds elapsed since tickInit, includes the live timer count
+ *
+ *@param[1]  -   void
+ *
+ *return     -   uint32_t
+ */
+uint32_t micros(void)
+{
+    uint32_t ticks;
+    uint16_t counts;
+    uint8_t hi, lo;
+    uint8_t et = TICK_ET;
+
+    TICK_ET = 0;
+    ticks = tickCount;
+
+    // The timer keeps running, re-read until the high byte did not change under the low byte
+    do
+    {
+        hi = TICK_TH;
+        lo = TICK_TL;
+    } while (hi != TICK_TH);
+
+    counts = (((uint16_t)hi << 8) | lo) - TICK_RELOAD;
+
+    // Overflowed but not yet serviced, a small count means it wrapped before the read
+    if (TICK_TF && counts < (TICK_COUNTS / 2))
+    {
+        ticks++;
+    }
+    TICK_ET = et;
+
+#if CLOCK_SOURCE != 12000000UL
+    counts = (uint16_t)(((uint32_t)counts * TICK_US_SCALE) >> 16);
+#endif
+
+    return ticks * TICK_PERIOD_US + counts;
+}
+
+/*
+ *@fn        -   tickIsr
+ *
+ *@brief     -   Tick interrupt service routine on the TICK_TIMER vector
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+#if TICK_TIMER == T2
+void tickIsr(void) __interrupt(TIMER2_VECTOR)
+#else
+void tickIsr(void) __interrupt(TIMER0_VECTOR)
+#endif
+{
+    uint8_t i;
+#if TICK_TIMER == T0 || TICK_FRACTION != 0
+    uint16_t reload = TICK_RELOAD;
+#endif
+#if TICK_TIMER == T0
+    uint16_t next;
+#endif
+
+#if TICK_FRACTION != 0
+    // One count longer whenever the dropped fractions make a whole count
+    fractionSum += TICK_FRACTION;
+    if (fractionSum >= 10000)
+    {
+        fractionSum -= 10000;
+        reload--;
+    }
+#endif
+
+#if TICK_TIMER == T2
+    TF2 = 0; // Timer 2 flag is not cleared by hardware
+#if TICK_FRACTION != 0
+    // The hardware already reloaded for this tick, RCAP2 sets the length of the next one
+    RCAP2L = reload & 0xFF;
+    RCAP2H = (reload >> 8) & 0xFF;
+#endif
+#else
+    // Add the reload to the count that built up since the overflow so latency does not drift
+    TR0 = 0;
+    next = (((uint16_t)TH0 << 8) | TL0) + (uint16_t)(reload + TICK_T0_FIXUP);
+    TL0 = next & 0xFF;
+    TH0 = (next >> 8) & 0xFF;
+    TR0 = 1;
+#endif
+
+    tickCount++;
+
+#if TICK_PERIOD_US != 1000
+    msFraction += TICK_PERIOD_US % 1000;
+    msCount += TICK_PERIOD_US / 1000;
+    if (msFraction >= 1000)
+    {
+        msFraction -= 1000;
+        msCount++;
+    }
+#endif
+
+    for (i = 0; i < hookCount; i++)
+    {
+        hooks[i]();
+    }
+}
@@ -0,0 +1,593 @@
+/*
+ * bench.c
+ * Description: Host benchmark of the driver entry points. Each row is the emulated machine
+ *              cycles of one call, i.e. SFR accesses, taken with hostCycles(). The rows are
+ *              printed as "name cycles". Given a baseline file in the same format, every row is
+ *              compared with it and a row more than BENCH_TOLERANCE percent slower is flagged.
+ *              Code between SFR accesses costs nothing on the host, so a row only moves when
+ *              the SFR traffic of a driver changes and pure computation is not benchmarked.
+ *              Compare the counts with other host runs, not with target cycles.
+ *              delay_us() rows give the signed error from 1 us to 1 s. `make bench` also builds
+ *              this file with -DCLOCK_SOURCE=11059200UL, its rows end in _11059kHz.
+ *              The timer wheel ISR works on RAM only, so its cost is reported in host
+ *              nanoseconds on comment lines that are never compared with the baseline.
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+/* clock_gettime under -std=c99 */
+#define _POSIX_C_SOURCE 199309L
+
+// Library for printf and the baseline file
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Libraries for the drivers under test
+#include "at89s52_gpio.h"
+#include "at89s52_timer.h"
+#include "at89s52_serial.h"
+#include "at89s52_tick.h"
+#include "at89s52_swtimer.h"
+#include "at89s52_spi.h"
+
+/* Allowed slowdown against the baseline in percent before a row is flagged */
+#ifndef BENCH_TOLERANCE
+#define BENCH_TOLERANCE 2
+#endif
+
+/* Calls averaged per row */
+#define BENCH_CALLS     16
+
+#define BENCH_NAME_MAX  40
+
+/* Rows of a build for another crystal carry its frequency in kHz, so one baseline holds both */
+#if CLOCK_SOURCE == 12000000UL
+#define BENCH_SUFFIX_KHZ    0
+#else
+#define BENCH_SUFFIX_KHZ    (CLOCK_SOURCE / 1000UL)
+#endif
+
+/* Wheel turns per timed swTimerTick run, armed timers must not expire sooner */
+#define BENCH_TURNS     4000
+#define BENCH_RUNS      5
+
+#if TICK_TIMER == T2
+#define BENCH_TICK_VECTOR   TIMER2_VECTOR
+#else
+#define BENCH_TICK_VECTOR   TIMER0_VECTOR
+#endif
+
+typedef long (*benchFn_t)(void);
+
+typedef struct
+{
+    const char *name;
+    benchFn_t fn;
+} bench_t;
+
+static uint32_t benchStart;
+
+#define BENCH_BEGIN()   (benchStart = hostCycles())
+#define BENCH_END(n)    ((long)((hostCycles() - benchStart + (n) / 2) / (n)))
+
+/*
+ *@fn        -   benchGpioPortWrite
+ *
+ *@brief     -   Function to time gpioPortWrite on a fixed port
+ *
+ *@param[1]  -   void
+ *
+ *return     -   long, cycles per call
+ */
+static long benchGpioPortWrite(void)
+{
+    uint8_t i;
+
+    BENCH_BEGIN();
+    for (i = 0; i < BENCH_CALLS; i++)
+    {
+        gpioPortWrite(PORT1, i);
+    }
+    return BENCH_END(BENCH_CALLS);
+}
+
+/*
+ *@fn        -   benchGpioPinWrite
+ *
+ *@brief     -   Function to time gpioPinWrite on a fixed pin
+ *
+ *@param[1]  -   void
+ *
+ *return     -   long, cycles per call
+ */
+static long benchGpioPinWrite(void)
+{
+    uint8_t i;
+
+    BENCH_BEGIN();
+    for (i = 0; i < BENCH_CALLS; i++)
+    {
+        gpioPinWrite(PORT1, 3, i & 1);
+    }
+    return BENCH_END(BENCH_CALLS);
+}
+
+/*
+ *@fn        -   benchGpioPortWriteMasked
+ *
+ *@brief     -   Function to time gpioPortWriteMasked on the low nibble of a port
+ *
+ *@param[1]  -   void
+ *
+ *return     -   long, cycles per call
+ */
+static long benchGpioPortWriteMasked(void)
+{
+    uint8_t i;
+
+    BENCH_BEGIN();
+    for (i = 0; i < BENCH_CALLS; i++)
+    {
+        gpioPortWriteMasked(PORT1, 0x0F, i);
+    }
+    return BENCH_END(BENCH_CALLS);
+}
+
+/*
+ *@fn        -   benchGpioPinRead
+ *
+ *@brief     -   Function to time gpioPinRead on a fixed pin
+ *
+ *@param[1]  -   void
+ *
+ *return     -   long, cycles per call
+ */
+static long benchGpioPinRead(void)
+{
+    uint8_t i;
+    uint8_t sum = 0;
+
+    BENCH_BEGIN();
+    for (i = 0; i < BENCH_CALLS; i++)
+    {
+        sum += gpioPinRead(PORT1, 3);
+    }
+    (void)sum;
+    return BENCH_END(BENCH_CALLS);
+}
+
+/*
+ *@fn        -   benchTimerLoad
+ *
+ *@brief     -   Function to time timerLoad of Timer 0
+ *
+ *@param[1]  -   void
+ *
+ *return     -   long, cycles per call
+ */
+static long benchTimerLoad(void)
+{
+    uint8_t i;
+
+    BENCH_BEGIN();
+    for (i = 0; i < BENCH_CALLS; i++)
+    {
+        timerLoad(T0, 0x1234);
+    }
+    return BENCH_END(BENCH_CALLS);
+}
+
+/*
+ *@fn        -   benchSerialPrintDecimal
+ *
+ *@brief     -   Function to time serialPrint of one %d on the polled UART
+ *
+ *@param[1]  -   void
+ *
+ *return     -   long, cycles per call
+ */
+static long benchSerialPrintDecimal(void)
+{
+    uint8_t i;
+
+    serialInit(9600);
+    hostUartSetByteCycles(1); // time the driver, not the wire
+
+    BENCH_BEGIN();
+    for (i = 0; i < BENCH_CALLS; i++)
+    {
+        serialPrint((uint8_t *)"%d\n", -12345);
+    }
+    while (hostUartTxPop() >= 0);
+    return BENCH_END(BENCH_CALLS);
+}
+
+/*
+ *@fn        -   benchDelayMsError
+ *
+ *@brief     -   Function to measure how far delay_ms(2) is off without the tick
+ *
+ *@param[1]  -   void
+ *
+ *return     -   long, cycles off the requested delay, negative if short
+ */
+static long benchDelayMsError(void)
+{
+    BENCH_BEGIN();
+    delay_ms(2);
+    return BENCH_END(1) - (long)(2UL * (CLOCK_SOURCE / 12UL) / 1000UL);
+}
+
+/*
+ *@fn        -   benchMillis
+ *
+ *@brief     -   Function to time millis with the tick running
+ *
+ *@param[1]  -   void
+ *
+ *return     -   long, cycles per call
+ */
+static long benchMillis(void)
+{
+    uint8_t i;
+    uint32_t sum = 0;
+
+    tickInit();
+    BENCH_BEGIN();
+    for (i = 0; i < BENCH_CALLS; i++)
+    {
+        sum += millis();
+    }
+    (void)sum;
+    return BENCH_END(BENCH_CALLS);
+}
+
+/*
+ *@fn        -   benchMicros
+ *
+ *@brief     -   Function to time micros with the tick running
+ *
+ *@param[1]  -   void
+ *
+ *return     -   long, cycles per call
+ */
+static long benchMicros(void)
+{
+    uint8_t i;
+    uint32_t sum = 0;
+
+    tickInit();
+    BENCH_BEGIN();
+    for (i = 0; i < BENCH_CALLS; i++)
+    {
+        sum += micros();
+    }
+    (void)sum;
+    return BENCH_END(BENCH_CALLS);
+}
+
+/*
+ *@fn        -   benchSpiWrite
+ *
+ *@brief     -   Function to time spiWrite of a BENCH_CALLS byte buffer in mode 0
+ *
+ *@param[1]  -   void
+ *
+ *return     -   long, cycles per byte
+ */
+static long benchSpiWrite(void)
+{
+    uint8_t buf[BENCH_CALLS] = {0x5A, 0xA5};
+
+    spiInit(SPI_MODE0);
+    BENCH_BEGIN();
+    spiWrite(buf, sizeof(buf));
+    return BENCH_END(sizeof(buf));
+}
+
+/*
+ *@fn        -   benchSpiRead
+ *
+ *@brief     -   Function to time spiRead of a BENCH_CALLS byte buffer in mode 0
+ *
+ *@param[1]  -   void
+ *
+ *return     -   long, cycles per byte
+ */
+static long benchSpiRead(void)
+{
+    uint8_t buf[BENCH_CALLS];
+
+    spiInit(SPI_MODE0);
+    BENCH_BEGIN();
+    spiRead(buf, sizeof(buf));
+    return BENCH_END(sizeof(buf));
+}
+
+/*
+ *@fn        -   benchSpiExchange
+ *
+ *@brief     -   Function to time spiExchange of a BENCH_CALLS byte buffer in mode 0
+ *
+ *@param[1]  -   void
+ *
+ *return     -   long, cycles per byte
+ */
+static long benchSpiExchange(void)
+{
+    uint8_t tx[BENCH_CALLS] = {0x5A, 0xA5};
+    uint8_t rx[BENCH_CALLS];
+
+    spiInit(SPI_MODE0);
+    BENCH_BEGIN();
+    spiExchange(tx, rx, sizeof(tx));
+    return BENCH_END(sizeof(tx));
+}
+
+/* delay_us() spans checked for accuracy, every path from the bare call to chunked timer loads */
+static const uint32_t delaySpans[] = {1, 5, 10, 20, 50, 100, 1000, 10000, 100000, 1000000};
+
+/*
+ *@fn        -   benchDelayUsError
+ *
+ *@brief     -   Function to measure how far delay_us() is off for one span
+ *
+ *@param[1]  -   Requested microseconds
+ *
+ *return     -   long, cycles off the requested delay, negative if short
+ */
+static long benchDelayUsError(uint32_t us)
+{
+    BENCH_BEGIN();
+    delay_us(us);
+    return BENCH_END(1) - (long)(((unsigned long long)us * (CLOCK_SOURCE / 12UL) + 500000ULL) / 1000000ULL);
+}
+
+static const bench_t benches[] =
+{
+    {"gpioPortWrite", benchGpioPortWrite},
+    {"gpioPinWrite", benchGpioPinWrite},
+    {"gpioPortWriteMasked", benchGpioPortWriteMasked},
+    {"gpioPinRead", benchGpioPinRead},
+    {"timerLoad", benchTimerLoad},
+    {"serialPrint_d", benchSerialPrintDecimal},
+    {"delay_ms_2_error", benchDelayMsError},
+    {"millis", benchMillis},
+    {"micros", benchMicros},
+    {"spiWrite_byte", benchSpiWrite},
+    {"spiRead_byte", benchSpiRead},
+    {"spiExchange_byte", benchSpiExchange},
+};
+
+/*
+ *@fn        -   benchWheelCallback
+ *
+ *@brief     -   Function to serve as an empty expiry callback
+ *
+ *@param[1]  -   Timer id
+ *
+ *return     -   void
+ */
+static void benchWheelCallback(uint8_t id)
+{
+    (void)id;
+}
+
+/*
+ *@fn        -   benchWheelTurns
+ *
+ *@brief     -   Function to time BENCH_TURNS turns of the wheel with timers parked in slot 0,
+ *               the fastest of BENCH_RUNS runs
+ *
+ *@param[1]  -   Timers in slot 0
+ *@param[2]  -   1 to make them periodic and expire on every turn, 0 to keep them counting rounds
+ *
+ *return     -   double, host nanoseconds
+ */
+static double benchWheelTurns(uint8_t armed, uint8_t expire)
+{
+    struct timespec t0, t1;
+    double best = 0;
+    uint8_t run;
+    uint8_t i;
+    uint32_t n;
+
+    for (run = 0; run < BENCH_RUNS; run++)
+    {
+        double ns;
+
+        hostReset();
+        swTimerInit();
+        for (i = 0; i < armed; i++)
+        {
+            uint8_t id = swTimerCreate(benchWheelCallback);
+            if (expire)
+            {
+                swTimerStart(id, SWTIMER_SLOTS, SWTIMER_SLOTS);
+            }
+            else
+            {
+                swTimerStart(id, (BENCH_TURNS + 1) * SWTIMER_SLOTS, 0);
+            }
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (n = 0; n < (uint32_t)BENCH_TURNS * SWTIMER_SLOTS; n++)
+        {
+            swTimerTick();
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+
+        ns = (t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec);
+        if (run == 0 || ns < best)
+        {
+            best = ns;
+        }
+    }
+
+    return best;
+}
+
+/*
+ *@fn        -   benchWheelReport
+ *
+ *@brief     -   Function to print the swTimerTick cost by the number of timers in the slot
+ *               it visits. Timers in other slots cost nothing on this tick
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void benchWheelReport(void)
+{
+    static const uint8_t counts[] = {1, 4, SWTIMER_MAX};
+    double empty = benchWheelTurns(0, 0);
+    double emptyTick = empty / ((double)BENCH_TURNS * SWTIMER_SLOTS);
+    uint8_t i;
+
+    printf("# swTimerTick host ns, not compared: one tick by timers in its slot\n");
+    printf("#   slot_0 %.1f\n", emptyTick);
+    for (i = 0; i < sizeof(counts); i++)
+    {
+        printf("#   slot_%u %.1f\n", counts[i],
+               emptyTick + (benchWheelTurns(counts[i], 0) - empty) / BENCH_TURNS);
+    }
+    printf("#   expire_%u %.1f\n", SWTIMER_MAX,
+           emptyTick + (benchWheelTurns(SWTIMER_MAX, 1) - empty) / BENCH_TURNS);
+}
+
+/*
+ *@fn        -   baselineFind
+ *
+ *@brief     -   Function to look up the baseline cycles of a row
+ *
+ *@param[1]  -   Baseline file, 0 if none was given
+ *@param[2]  -   Row name
+ *@param[3]  -   Baseline cycles, written when the row is found
+ *
+ *return     -   int, 1 if the row is in the baseline
+ */
+static int baselineFind(FILE *file, const char *name, long *cycles)
+{
+    char line[128];
+    char rowName[BENCH_NAME_MAX + 1];
+    long rowCycles;
+
+    if (!file)
+    {
+        return 0;
+    }
+
+    rewind(file);
+    while (fgets(line, sizeof(line), file))
+    {
+        if (line[0] == '#')
+        {
+            continue;
+        }
+        if (sscanf(line, "%40s %ld", rowName, &rowCycles) == 2 && strcmp(rowName, name) == 0)
+        {
+            *cycles = rowCycles;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/*
+ *@fn        -   benchRow
+ *
+ *@brief     -   Function to print one row and compare it with the baseline
+ *
+ *@param[1]  -   Baseline file, 0 if none was given
+ *@param[2]  -   Row name, the crystal is appended when it is not 12 MHz
+ *@param[3]  -   Measured cycles
+ *
+ *return     -   unsigned, 1 if the row regressed
+ */
+static unsigned benchRow(FILE *baseline, const char *name, long cycles)
+{
+    char row[BENCH_NAME_MAX + 1];
+    long base;
+
+    if (BENCH_SUFFIX_KHZ)
+    {
+        sprintf(row, "%.24s_%lukHz", name, (unsigned long)BENCH_SUFFIX_KHZ);
+    }
+    else
+    {
+        sprintf(row, "%.32s", name);
+    }
+
+    if (!baselineFind(baseline, row, &base))
+    {
+        printf("%-32s %8ld%s\n", row, cycles, baseline ? "        -  new" : "");
+        return 0;
+    }
+
+    // Delay rows are signed errors, a regression is a larger error either way
+    printf("%-32s %8ld %8ld %+5ld%%", row, cycles, base,
+           base ? (labs(cycles) - labs(base)) * 100 / labs(base) : 0);
+    if (labs(cycles) * 100 > labs(base) * (100 + BENCH_TOLERANCE))
+    {
+        printf("  REGRESSION\n");
+        return 1;
+    }
+    printf("\n");
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    FILE *baseline = 0;
+    unsigned regressions = 0;
+    size_t i;
+
+    if (argc > 1)
+    {
+        baseline = fopen(argv[1], "r");
+        if (!baseline)
+        {
+            fprintf(stderr, "bench: cannot open %s\n", argv[1]);
+            return 2;
+        }
+    }
+
+    hostAttachIsr(BENCH_TICK_VECTOR, tickIsr);
+
+    printf("# name cycles%s\n", baseline ? " baseline change" : "");
+    for (i = 0; i < sizeof(benches) / sizeof(benches[0]); i++)
+    {
+        hostReset();
+        hostUartSetByteCycles(1000);
+        regressions += benchRow(baseline, benches[i].name, benches[i].fn());
+    }
+    for (i = 0; i < sizeof(delaySpans) / sizeof(delaySpans[0]); i++)
+    {
+        char name[BENCH_NAME_MAX + 1];
+
+        hostReset();
+        sprintf(name, "delay_us_%lu_error", (unsigned long)delaySpans[i]);
+        regressions += benchRow(baseline, name, benchDelayUsError(delaySpans[i]));
+    }
+
+    if (!BENCH_SUFFIX_KHZ)
+    {
+        benchWheelReport(); // RAM only, the crystal does not change it
+    }
+
+    if (baseline)
+    {
+        fclose(baseline);
+        if (regressions)
+        {
+            printf("%u regression(s) against %s\n", regressions, argv[1]);
+        }
+    }
+
+    return regressions != 0;
+}
@@ -0,0 +1,50 @@
+#ifndef TEST_H
+#define TEST_H
+
+/*
+ * test.h
+ * Description: Check macros shared by the host test programs. Every test is a plain main()
+ *              that `make test` builds with -DAT89S52_HOST against the driver sources. A failed
+ *              check prints its location and the test exits non-zero.
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for printf
+#include <stdio.h>
+
+// Library for the emulator control functions
+#include "at89s52.h"
+
+static unsigned testFailures;
+
+/* Record a failure when the condition is false */
+#define CHECK(cond)                                                                 \
+    do                                                                              \
+    {                                                                               \
+        if (!(cond))                                                                \
+        {                                                                           \
+            printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond);         \
+            testFailures++;                                                         \
+        }                                                                           \
+    } while (0)
+
+/* Record a failure when two integer values differ, printing both */
+#define CHECK_EQ(actual, expected)                                                  \
+    do                                                                              \
+    {                                                                               \
+        long testActual = (long)(actual);                                           \
+        long testExpected = (long)(expected);                                       \
+        if (testActual != testExpected)                                             \
+        {                                                                           \
+            printf("%s:%d: %s is %ld, expected %ld\n", __FILE__, __LINE__,          \
+                   #actual, testActual, testExpected);                              \
+            testFailures++;                                                         \
+        }                                                                           \
+    } while (0)
+
+/* Exit status of main(), prints the verdict */
+#define TEST_RESULT()   (printf("%s: %s\n", __FILE__, testFailures ? "FAIL" : "ok"), testFailures != 0)
+
+#endif // TEST_H
@@ -0,0 +1,171 @@
+/*
+ * test_debounce.c
+ * Description: Host test of the vertical counter debouncer. Pin levels are written straight
+ *              into the emulated P1 and debounceSample() is called once per sample, so every
+ *              change is checked against an exact sample count: taken after 4 equal samples,
+ *              ignored for a glitch of 1 to 3 samples, pins outside the mask never reported.
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for the check macros
+#include "test.h"
+
+// Library under test
+#include "at89s52_debounce.h"
+
+/* Pins of P1 the tests debounce, active low */
+#define PINS    0x0F
+
+static uint8_t channel;
+
+/*
+ *@fn        -   pins
+ *
+ *@brief     -   Function to set the P1 pin levels without stepping the emulation
+ *
+ *@param[1]  -   Pin levels, 0 for a pressed pin
+ *
+ *return     -   void
+ */
+static void pins(uint8_t level)
+{
+    hostSfrFile[0x90 - 0x80].byte = level;
+}
+
+/*
+ *@fn        -   samples
+ *
+ *@brief     -   Function to take a number of samples
+ *
+ *@param[1]  -   Number of samples
+ *
+ *return     -   void
+ */
+static void samples(uint8_t n)
+{
+    while (n--)
+    {
+        debounceSample();
+    }
+}
+
+/*
+ *@fn        -   setup
+ *
+ *@brief     -   Function to reset the emulator and debounce PINS of P1, all released
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void setup(void)
+{
+    hostReset();
+    debounceInit(); // the tick never runs here, samples are taken by hand
+    channel = debounceAdd(PORT1, PINS);
+    pins(0xFF);
+}
+
+/*
+ *@fn        -   testPressRelease
+ *
+ *@brief     -   Function to check that a press and a release are taken on the 4th equal sample
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void testPressRelease(void)
+{
+    setup();
+    CHECK_EQ(channel, 0);
+
+    pins(0xFE);
+    samples(3);
+    CHECK_EQ(debounceState(channel), 0);
+    CHECK_EQ(debouncePressed(channel), 0);
+    samples(1);
+    CHECK_EQ(debounceState(channel), 0x01);
+    CHECK_EQ(debouncePressed(channel), 0x01);
+    CHECK_EQ(debouncePressed(channel), 0); // taken by the previous call
+
+    pins(0xFF);
+    samples(3);
+    CHECK_EQ(debounceReleased(channel), 0);
+    samples(1);
+    CHECK_EQ(debounceState(channel), 0);
+    CHECK_EQ(debounceReleased(channel), 0x01);
+    CHECK_EQ(debouncePressed(channel), 0);
+}
+
+/*
+ *@fn        -   testGlitch
+ *
+ *@brief     -   Function to check that 1 to 3 sample glitches give no edge either way
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void testGlitch(void)
+{
+    uint8_t n;
+
+    setup();
+    for (n = 1; n <= 3; n++)
+    {
+        pins(0xFD);
+        samples(n);
+        pins(0xFF);
+        samples(4);
+        CHECK_EQ(debounceState(channel), 0);
+        CHECK_EQ(debouncePressed(channel), 0);
+    }
+
+    pins(0xFD);
+    samples(4);
+    CHECK_EQ(debouncePressed(channel), 0x02);
+    for (n = 1; n <= 3; n++)
+    {
+        pins(0xFF);
+        samples(n);
+        pins(0xFD);
+        samples(4);
+        CHECK_EQ(debounceState(channel), 0x02);
+        CHECK_EQ(debounceReleased(channel), 0);
+    }
+}
+
+/*
+ *@fn        -   testParallel
+ *
+ *@brief     -   Function to check that pins count on their own and pins outside the mask are ignored
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void testParallel(void)
+{
+    setup();
+
+    pins(0x7E); // pin 0 and pin 7, which is not debounced
+    samples(2);
+    pins(0x7A); // pin 2 joins two samples later
+    samples(2);
+    CHECK_EQ(debouncePressed(channel), 0x01);
+    samples(2);
+    CHECK_EQ(debouncePressed(channel), 0x04);
+    CHECK_EQ(debounceState(channel), 0x05);
+}
+
+int main(void)
+{
+    testPressRelease();
+    testGlitch();
+    testParallel();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,58 @@
+/*
+ * test_ds18b20.c
+ * Description: Host test of the DS18B20 scratchpad checks. A bus held low answers the reset
+ *              with a presence pulse and then reads all zeros, whose CRC-8 is 0 too. The read
+ *              must fail instead of returning 0 degrees.
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for the check macros
+#include "test.h"
+
+// Library under test
+#include "at89s52_ds18b20.h"
+
+/*
+ *@fn        -   holdLowHook
+ *
+ *@brief     -   Function to pull the 1-Wire line (P3.7) low on every cycle
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void holdLowHook(void)
+{
+    hostSfrFile[0xB0 - 0x80].bit.b7 = 0;
+}
+
+/*
+ *@fn        -   testBusHeldLow
+ *
+ *@brief     -   Function to check that an all-zero scratchpad is rejected
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void testBusHeldLow(void)
+{
+    int16_t temp = 0x55;
+
+    hostReset();
+    hostSetHook(holdLowHook);
+
+    CHECK_EQ(ds18b20Read(0, &temp), ONEWIRE_CRC_ERROR);
+    CHECK_EQ(temp, 0x55); // left alone on failure
+
+    hostSetHook(0);
+}
+
+int main(void)
+{
+    testBusHeldLow();
+
+    return TEST_RESULT();
+}
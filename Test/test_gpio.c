@@ -0,0 +1,157 @@
+/*
+ * test_gpio.c
+ * Description: Host test of the GPIO shadow registers under interrupts. An INT0 ISR raised every
+ *              few cycles updates a bit of P2 through GPIO_PORT_SET_CLEAR() while main updates the
+ *              other bits through the functions, then the Timer 0 PWM runs on the low bits of P2
+ *              while main writes the high bit. No write may be lost and the shadow must match the
+ *              port. The emulator only takes an interrupt at a register access, so a race inside
+ *              the RAM update of a function body is not reachable here. Built with
+ *              -DGPIO_USE_SHADOW -DPWM_CHANNELS=4.
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for the check macros
+#include "test.h"
+
+// Libraries under test
+#include "at89s52_gpio.h"
+#include "at89s52_pwm.h"
+
+/* Machine cycles between two INT0 requests, odd so it drifts across the function bodies */
+#define INT0_PERIOD 37
+
+static uint8_t raiseInt0;
+static unsigned isrToggles;
+static uint32_t samples, highSamples;
+
+/*
+ *@fn        -   raiseHook
+ *
+ *@brief     -   Function to request INT0 every INT0_PERIOD cycles and sample PWM channel 0
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void raiseHook(void)
+{
+    if (raiseInt0 && hostCycles() % INT0_PERIOD == 0)
+    {
+        hostSfrFile[0x88 - 0x80].bit.b1 = 1; // IE0
+    }
+
+    samples++;
+    highSamples += hostSfrFile[0xA0 - 0x80].bit.b0;
+}
+
+/*
+ *@fn        -   toggleIsr
+ *
+ *@brief     -   Function to flip P2.7 through the shadow on every INT0
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void toggleIsr(void)
+{
+    isrToggles++;
+    if (isrToggles & 1)
+    {
+        GPIO_PORT_SET_CLEAR(P2, 0x80, 0);
+    }
+    else
+    {
+        GPIO_PORT_SET_CLEAR(P2, 0, 0x80);
+    }
+}
+
+/*
+ *@fn        -   testIsrAndMain
+ *
+ *@brief     -   Function to check that ISR and main updates of one shadow both survive
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void testIsrAndMain(void)
+{
+    uint16_t i;
+    uint8_t bit;
+
+    hostReset();
+    hostSetHook(raiseHook);
+    hostAttachIsr(INT0_VECTOR, toggleIsr);
+    gpioPortWrite(PORT2, 0x00);
+
+    isrToggles = 0;
+    raiseInt0 = 1;
+    IT0 = 1;
+    EX0 = 1;
+    EA = 1;
+
+    for (i = 0; i < 3000; i++)
+    {
+        bit = (uint8_t)(i & 1);
+        gpioPortSetClear(PORT2, bit ? 0x01 : 0, bit ? 0 : 0x01);
+        gpioPinWrite(PORT2, 1, bit);
+        gpioPinToggle(PORT2, 2);
+        GPIO_PORT_WRITE_MASKED(P2, 0x08, bit ? 0x08 : 0);
+    }
+
+    EA = 0;
+    raiseInt0 = 0;
+    CHECK(isrToggles > 1000);
+    CHECK_EQ(P2, gpioShadowRead(PORT2));
+    CHECK_EQ(P2 >> 7, isrToggles & 1);
+    CHECK_EQ(P2 & 0x0F, 0x0B); // the last pass wrote 1 to bits 0, 1 and 3 and left bit 2 at 1
+}
+
+/*
+ *@fn        -   testPwmAndMain
+ *
+ *@brief     -   Function to check that main writes to P2.7 leave the PWM on the low bits alone
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void testPwmAndMain(void)
+{
+    uint32_t end;
+    uint8_t bit = 0;
+
+    hostReset();
+    hostSetHook(raiseHook);
+    hostAttachIsr(INT0_VECTOR, 0);
+    hostAttachIsr(TIMER0_VECTOR, pwmIsr);
+    gpioPortWrite(PORT2, 0x00);
+
+    pwmInit();
+    pwmWrite(0, PWM_STEPS / 4);
+    hostStep(2 * PWM_PERIOD_COUNTS); // let the new schedule swap in
+
+    samples = highSamples = 0;
+    end = hostCycles() + 10UL * PWM_PERIOD_COUNTS;
+    while (hostCycles() < end)
+    {
+        bit ^= 1;
+        gpioPinWrite(PORT2, 7, bit);
+    }
+    CHECK(highSamples * 100 / samples >= 23 && highSamples * 100 / samples <= 27);
+
+    pwmStop();
+    CHECK_EQ(P2, gpioShadowRead(PORT2));
+    CHECK_EQ(P2, bit << 7);
+}
+
+int main(void)
+{
+    testIsrAndMain();
+    testPwmAndMain();
+
+    return TEST_RESULT();
+}
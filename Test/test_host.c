@@ -0,0 +1,186 @@
+/*
+ * test_host.c
+ * Description: Host test of the SFR emulator itself. Checks the reset values, that one SFR
+ *              access costs one machine cycle, the Timer 0/1/2 overflow points, edge triggered
+ *              INT0 dispatch and the byte level UART.
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for the check macros
+#include "test.h"
+
+/* Raw register cell, setting up through it does not advance the emulation */
+#define RAW(addr)   (hostSfrFile[(addr) - 0x80].byte)
+
+static unsigned isrCalls;
+
+/*
+ *@fn        -   countIsr
+ *
+ *@brief     -   Function to count how often the dispatcher called the attached ISR
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void countIsr(void)
+{
+    isrCalls++;
+}
+
+/*
+ *@fn        -   testReset
+ *
+ *@brief     -   Function to check the reset values and the cost of one SFR access
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void testReset(void)
+{
+    uint32_t start;
+
+    hostReset();
+    CHECK_EQ(RAW(0x80), 0xFF);
+    CHECK_EQ(RAW(0x90), 0xFF);
+    CHECK_EQ(RAW(0xA0), 0xFF);
+    CHECK_EQ(RAW(0xB0), 0xFF);
+    CHECK_EQ(RAW(0x81), 0x07);
+    CHECK_EQ(hostCycles(), 0);
+
+    start = hostCycles();
+    (void)P1;
+    P1_0 = 0;
+    CHECK_EQ(hostCycles() - start, 2);
+    CHECK_EQ(RAW(0x90), 0xFE);
+}
+
+/*
+ *@fn        -   testTimers
+ *
+ *@brief     -   Function to check where Timer 0 mode 1, Timer 1 mode 2 and Timer 2 overflow
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void testTimers(void)
+{
+    hostReset();
+    RAW(0x89) = (TIMER_MODE2 << 4) | TIMER_MODE1;
+    RAW(0x8C) = 0xFF; // TH0
+    RAW(0x8A) = 0xF0; // TL0
+    RAW(0x8D) = 0xFE; // TH1
+    RAW(0x8B) = 0xFE; // TL1
+    RAW(0x88) = 0x50; // TR0 and TR1
+
+    hostStep(1);
+    CHECK_EQ(RAW(0x88) & 0x80, 0);
+    hostStep(1);
+    CHECK_EQ(RAW(0x88) & 0x80, 0x80); // TF1 after 2 counts
+    CHECK_EQ(RAW(0x8B), 0xFE);        // TL1 reloaded from TH1
+
+    hostStep(13);
+    CHECK_EQ(RAW(0x88) & 0x20, 0);
+    hostStep(1);
+    CHECK_EQ(RAW(0x88) & 0x20, 0x20); // TF0 after 16 counts
+    CHECK_EQ(RAW(0x8A), 0x00);
+    CHECK_EQ(RAW(0x8C), 0x00);
+
+    hostReset();
+    RAW(0xCB) = 0xFF; // RCAP2H
+    RAW(0xCA) = 0xF8; // RCAP2L
+    RAW(0xCD) = 0xFF; // TH2
+    RAW(0xCC) = 0xF8; // TL2
+    RAW(0xC8) = 0x04; // TR2, auto reload
+    hostStep(7);
+    CHECK_EQ(RAW(0xC8) & 0x80, 0);
+    hostStep(1);
+    CHECK_EQ(RAW(0xC8) & 0x80, 0x80); // TF2 after 8 counts
+    CHECK_EQ(RAW(0xCC), 0xF8);
+    CHECK_EQ(RAW(0xCD), 0xFF);
+}
+
+/*
+ *@fn        -   testInterrupts
+ *
+ *@brief     -   Function to check edge triggered INT0 and Timer 0 dispatch
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void testInterrupts(void)
+{
+    hostReset();
+    hostAttachIsr(INT0_VECTOR, countIsr);
+    isrCalls = 0;
+    IT0 = 1;
+    EX0 = 1;
+    EA = 1;
+
+    P3_2 = 0;
+    hostStep(10);
+    CHECK_EQ(isrCalls, 1); // one falling edge, one call
+    CHECK_EQ(IE0, 0);      // cleared on vectoring
+    P3_2 = 1;
+    hostStep(10);
+    CHECK_EQ(isrCalls, 1);
+
+    hostAttachIsr(INT0_VECTOR, 0);
+    hostAttachIsr(TIMER0_VECTOR, countIsr);
+    isrCalls = 0;
+    EX0 = 0;
+    TMOD = TIMER_MODE2;
+    TH0 = 0;
+    TL0 = 0;
+    ET0 = 1;
+    TR0 = 1;
+    hostStep(256 * 4);
+    CHECK(isrCalls >= 3 && isrCalls <= 4);
+    hostAttachIsr(TIMER0_VECTOR, 0);
+}
+
+/*
+ *@fn        -   testUart
+ *
+ *@brief     -   Function to check that the fake UART sends and receives a byte in the set time
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void testUart(void)
+{
+    hostReset();
+    hostUartSetByteCycles(100);
+
+    SBUF = 'A';
+    hostStep(98);
+    CHECK_EQ(TI, 0);
+    CHECK_EQ(TI, 1);
+    CHECK_EQ(hostUartTxPop(), 'A');
+    CHECK_EQ(hostUartTxPop(), -1);
+
+    SCON = 0x50; // mode 1, REN
+    CHECK_EQ(hostUartRxPush(0x55), 1);
+    hostStep(99); // one cycle to start the frame, then 100 for the byte
+    CHECK_EQ(RI, 0);
+    CHECK_EQ(RI, 1);
+    CHECK_EQ(SBUF & 0xFF, 0x55);
+
+    hostUartSetByteCycles(1000);
+}
+
+int main(void)
+{
+    testReset();
+    testTimers();
+    testInterrupts();
+    testUart();
+
+    return TEST_RESULT();
+}
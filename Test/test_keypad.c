@@ -0,0 +1,196 @@
+/*
+ * test_keypad.c
+ * Description: Host test of the matrix keypad scanner on the default 4x4 wiring, rows on P2
+ *              and columns on P1. A cycle hook models a matrix without diodes: a row driven
+ *              low pulls down every column it reaches through held keys, across other rows
+ *              too, so three keys on the corners of a rectangle show the fourth as a ghost.
+ *              The scan runs from the real Timer 2 tick.
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for the check macros
+#include "test.h"
+
+// Library under test
+#include "at89s52_keypad.h"
+
+/* Held keys, a column mask per row */
+static uint8_t held[KEYPAD_ROWS];
+
+/*
+ *@fn        -   matrixHook
+ *
+ *@brief     -   Function to set the column pins from the driven rows and the held keys
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void matrixHook(void)
+{
+    uint8_t lowRows = ~hostSfrFile[0xA0 - 0x80].byte & ((1 << KEYPAD_ROWS) - 1);
+    uint8_t lowCols = 0;
+    uint8_t before;
+    uint8_t r;
+
+    // Spread the low level through held keys until nothing changes
+    do
+    {
+        before = lowRows | (lowCols << 4);
+        for (r = 0; r < KEYPAD_ROWS; r++)
+        {
+            if (lowRows & (1 << r))
+            {
+                lowCols |= held[r];
+            }
+            if (lowCols & held[r])
+            {
+                lowRows |= 1 << r;
+            }
+        }
+    } while (before != (uint8_t)(lowRows | (lowCols << 4)));
+
+    hostSfrFile[0x90 - 0x80].byte = (uint8_t)~lowCols;
+}
+
+/*
+ *@fn        -   ticks
+ *
+ *@brief     -   Function to run the emulation for a number of ticks
+ *
+ *@param[1]  -   Number of ticks
+ *
+ *return     -   void
+ */
+static void ticks(uint32_t n)
+{
+    uint32_t end = tickCount + n;
+
+    while (tickCount != end)
+    {
+        hostStep(1);
+    }
+}
+
+/*
+ *@fn        -   drain
+ *
+ *@brief     -   Function to throw away the waiting events
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void drain(void)
+{
+    uint8_t event;
+
+    while (keypadRead(&event));
+}
+
+/*
+ *@fn        -   testTwoScans
+ *
+ *@brief     -   Function to check that a press and a release are taken on the second
+ *               agreeing scan, not the first
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void testTwoScans(void)
+{
+    uint8_t event = 0;
+
+    held[2] = 0x08;
+    ticks(KEYPAD_ROWS);
+    CHECK_EQ(keypadAvailable(), 0);
+    ticks(KEYPAD_ROWS);
+    CHECK_EQ(keypadAvailable(), 1);
+    CHECK(keypadRead(&event));
+    CHECK_EQ(event, (2 << 3) | 3);
+    CHECK_EQ(keypadRow(2), 0x08);
+
+    held[2] = 0;
+    ticks(KEYPAD_ROWS);
+    CHECK_EQ(keypadAvailable(), 0);
+    ticks(KEYPAD_ROWS);
+    CHECK(keypadRead(&event));
+    CHECK_EQ(event, KEYPAD_RELEASED | (2 << 3) | 3);
+    CHECK_EQ(keypadRow(2), 0);
+}
+
+/*
+ *@fn        -   testGhost
+ *
+ *@brief     -   Function to check that three keys on a rectangle are ignored as a ghosted
+ *               scan and the two left after a release are taken
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void testGhost(void)
+{
+    held[0] = 0x03;
+    held[1] = 0x01;
+    ticks(2 * KEYPAD_ROWS);
+    CHECK_EQ(keypadGhosted(), 1);
+    CHECK_EQ(keypadAvailable(), 0);
+    CHECK_EQ(keypadRow(0), 0);
+    CHECK_EQ(keypadRow(1), 0);
+
+    held[1] = 0;
+    ticks(2 * KEYPAD_ROWS);
+    CHECK_EQ(keypadGhosted(), 0);
+    CHECK_EQ(keypadAvailable(), 2);
+    CHECK_EQ(keypadRow(0), 0x03);
+
+    held[0] = 0;
+    ticks(2 * KEYPAD_ROWS);
+    drain();
+}
+
+/*
+ *@fn        -   testOverflow
+ *
+ *@brief     -   Function to check that events past a full FIFO are counted and dropped
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void testOverflow(void)
+{
+    uint8_t lost = keypadOverflows();
+
+    held[3] = 0x0F; // one row, no rectangle
+    ticks(2 * KEYPAD_ROWS);
+    held[3] = 0;
+    ticks(2 * KEYPAD_ROWS);
+    held[3] = 0x0F;
+    ticks(2 * KEYPAD_ROWS);
+
+    CHECK_EQ(keypadAvailable(), KEYPAD_FIFO_SIZE);
+    CHECK_EQ((uint8_t)(keypadOverflows() - lost), 3 * 4 - KEYPAD_FIFO_SIZE);
+    CHECK_EQ(keypadRow(3), 0x0F);
+    drain();
+}
+
+int main(void)
+{
+    // keypadInit attaches a tick hook, so it runs once and the tests continue its state
+    hostReset();
+    hostAttachIsr(TIMER2_VECTOR, tickIsr);
+    hostSetHook(matrixHook);
+    CHECK(keypadInit());
+    tickInit();
+
+    testTwoScans();
+    testGhost();
+    testOverflow();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,92 @@
+/*
+ * test_log.c
+ * Description: Host test of the binary log against its decoder. Every entry of the format
+ *              table is logged with the macro its comment names, the record is taken off the
+ *              emulated UART and handed to printRecord() of Tools/logdecode.c, which must find
+ *              exactly the argument bytes its format asks for.
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for the check macros
+#include "test.h"
+
+// Libraries under test
+#include "at89s52_log.h"
+#include "at89s52_serial.h"
+
+// The decoder itself, its main() is renamed out of the way
+#define main logdecodeMain
+#include "../Tools/logdecode.c"
+#undef main
+
+/*
+ *@fn        -   takeRecord
+ *
+ *@brief     -   Function to pop one record off the UART and check it with the decoder
+ *
+ *@param[1]  -   Format id the record must carry
+ *@param[2]  -   Number of argument bytes it must carry
+ *
+ *return     -   void
+ */
+static void takeRecord(uint8_t id, uint8_t len)
+{
+    uint8_t header[LOG_HEADER_SIZE];
+    uint8_t args[LOG_MAX_ARGS];
+    uint8_t i;
+
+    for (i = 0; i < LOG_HEADER_SIZE; i++)
+    {
+        header[i] = (uint8_t)hostUartTxPop();
+    }
+    CHECK_EQ(header[0], LOG_SYNC);
+    CHECK_EQ(header[1], id);
+    CHECK_EQ(header[2], len);
+
+    for (i = 0; i < header[2] && i < LOG_MAX_ARGS; i++)
+    {
+        args[i] = (uint8_t)hostUartTxPop();
+    }
+    printf("    %-10s ", names[id]);
+    CHECK(printRecord(formats[id], args, header[2]));
+    putchar('\n');
+}
+
+/*
+ *@fn        -   testFormatTable
+ *
+ *@brief     -   Function to log every table entry and decode it
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void testFormatTable(void)
+{
+    hostReset();
+    serialInit(9600);
+    hostUartSetByteCycles(1);
+
+    LOG0(LOG_BOOT);
+    takeRecord(LOG_BOOT, 0);
+    LOGL1_1(LOG_BAUD, 115200L, -16);
+    takeRecord(LOG_BAUD, 6);
+    LOG1(LOG_VALUE, -5);
+    takeRecord(LOG_VALUE, 2);
+    LOG2(LOG_VALUE2, 1, 2);
+    takeRecord(LOG_VALUE2, 4);
+    LOG2(LOG_REGISTER, 0x89, 0x21);
+    takeRecord(LOG_REGISTER, 4);
+
+    CHECK_EQ(hostUartTxPop(), -1);
+    CHECK_EQ(LOG_FORMAT_COUNT, FORMAT_COUNT); // a new entry needs a line above
+}
+
+int main(void)
+{
+    testFormatTable();
+
+    return TEST_RESULT();
+}
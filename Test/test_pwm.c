@@ -0,0 +1,156 @@
+/*
+ * test_pwm.c
+ * Description: Host test of the Timer 0 software PWM. Checks the duty of a channel and that
+ *              delay_us()/delay_ms() still return while the PWM ISR owns Timer 0 and no tick
+ *              is running, and that pwmStop() leaves the other interrupts enabled. A watchdog
+ *              hook fails the test instead of hanging in a delay.
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for exit
+#include <stdlib.h>
+
+// Library for the check macros
+#include "test.h"
+
+// Libraries under test
+#include "at89s52_pwm.h"
+#include "at89s52_timer.h"
+#include "at89s52_tick.h"
+
+/* Machine cycles a single test step may take before the watchdog fails it */
+#define WATCHDOG_CYCLES 200000UL
+
+static uint32_t watchdogStart;
+static uint32_t samples, highSamples;
+
+/*
+ *@fn        -   sampleHook
+ *
+ *@brief     -   Function to sample channel 0 on every cycle and stop a run that hangs
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void sampleHook(void)
+{
+    samples++;
+    highSamples += hostSfrFile[0xA0 - 0x80].bit.b0;
+
+    if (hostCycles() - watchdogStart > WATCHDOG_CYCLES)
+    {
+        printf("%s: watchdog, no return after %lu cycles\n", __FILE__, WATCHDOG_CYCLES);
+        exit(1);
+    }
+}
+
+/*
+ *@fn        -   start
+ *
+ *@brief     -   Function to reset the emulator and start the PWM with channel 0 at a duty
+ *
+ *@param[1]  -   Duty of channel 0
+ *
+ *return     -   void
+ */
+static void start(uint8_t duty)
+{
+    hostReset();
+    hostAttachIsr(TIMER0_VECTOR, pwmIsr);
+    watchdogStart = 0;
+    hostSetHook(sampleHook);
+
+    pwmInit();
+    pwmWrite(0, duty);
+    hostStep(2 * PWM_PERIOD_COUNTS); // let the new schedule swap in
+}
+
+/*
+ *@fn        -   testDuty
+ *
+ *@brief     -   Function to check the high time of channel 0 over whole periods
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void testDuty(void)
+{
+    start(PWM_STEPS / 4);
+
+    watchdogStart = hostCycles();
+    samples = highSamples = 0;
+    hostStep(10 * PWM_PERIOD_COUNTS);
+    CHECK(highSamples * 100 / samples >= 23 && highSamples * 100 / samples <= 27);
+
+    pwmStop();
+    CHECK_EQ(P2 & 0x01, 0);
+}
+
+/*
+ *@fn        -   testStopKeepsInterrupts
+ *
+ *@brief     -   Function to check that pwmStop leaves EA and the Timer 2 tick running
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void testStopKeepsInterrupts(void)
+{
+    uint32_t ticks;
+
+    start(PWM_STEPS / 2);
+    hostAttachIsr(TIMER2_VECTOR, tickIsr);
+    tickInit();
+
+    pwmStop();
+    CHECK_EQ(EA, 1);
+    CHECK_EQ(ET0, 0);
+    CHECK_EQ(TR0, 0);
+
+    watchdogStart = hostCycles();
+    ticks = tickCount;
+    hostStep(20000);
+    CHECK(tickCount - ticks >= 19);
+
+    hostAttachIsr(TIMER2_VECTOR, 0);
+}
+
+/*
+ *@fn        -   testDelaysWithoutTick
+ *
+ *@brief     -   Function to check that both delays return while the PWM holds Timer 0
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void testDelaysWithoutTick(void)
+{
+    start(PWM_STEPS / 2);
+
+    watchdogStart = hostCycles();
+    delay_us(500);
+    CHECK_EQ(TR0, 1);
+
+    watchdogStart = hostCycles();
+    samples = highSamples = 0;
+    delay_ms(20);
+    CHECK_EQ(TR0, 1);
+    CHECK(highSamples > 0 && highSamples < samples); // the PWM kept running meanwhile
+
+    pwmStop();
+}
+
+int main(void)
+{
+    testDuty();
+    testDelaysWithoutTick();
+    testStopKeepsInterrupts();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,220 @@
+/*
+ * test_swtimer.c
+ * Description: Host test of the software timer wheel. The wheel is advanced by calling
+ *              swTimerTick() directly, so every expiry lands on a known tick. Covers one-shot,
+ *              periodic and multi-round timers and callbacks that start, stop or delete other
+ *              timers expiring in the same tick.
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for the check macros
+#include "test.h"
+
+// Library under test
+#include "at89s52_swtimer.h"
+
+static uint8_t idA, idB, idC;
+static unsigned callsA, callsB, callsC;
+static uint8_t actionA;
+
+/* What callbackA does to timer B */
+#define ACTION_NONE     0
+#define ACTION_RESTART  1
+#define ACTION_STOP     2
+#define ACTION_DELETE   3
+
+/*
+ *@fn        -   callbackA
+ *
+ *@brief     -   Function to count expiries of timer A and apply actionA to timer B
+ *
+ *@param[1]  -   Timer id
+ *
+ *return     -   void
+ */
+static void callbackA(uint8_t id)
+{
+    (void)id;
+    callsA++;
+
+    switch (actionA)
+    {
+    case ACTION_RESTART:
+        swTimerStart(idB, 3, 0);
+        break;
+    case ACTION_STOP:
+        swTimerStop(idB);
+        break;
+    case ACTION_DELETE:
+        swTimerDelete(idB);
+        break;
+    }
+}
+
+/*
+ *@fn        -   callbackB
+ *
+ *@brief     -   Function to count expiries of timer B
+ *
+ *@param[1]  -   Timer id
+ *
+ *return     -   void
+ */
+static void callbackB(uint8_t id)
+{
+    (void)id;
+    callsB++;
+}
+
+/*
+ *@fn        -   callbackC
+ *
+ *@brief     -   Function to count expiries of timer C
+ *
+ *@param[1]  -   Timer id
+ *
+ *return     -   void
+ */
+static void callbackC(uint8_t id)
+{
+    (void)id;
+    callsC++;
+}
+
+/*
+ *@fn        -   ticks
+ *
+ *@brief     -   Function to advance the wheel a number of ticks
+ *
+ *@param[1]  -   Number of ticks
+ *
+ *return     -   void
+ */
+static void ticks(uint16_t n)
+{
+    while (n--)
+    {
+        swTimerTick();
+    }
+}
+
+/*
+ *@fn        -   setup
+ *
+ *@brief     -   Function to reset the wheel and arm A, B and C to expire on tick 5, C periodic
+ *
+ *@param[1]  -   What callbackA does to B
+ *
+ *return     -   void
+ */
+static void setup(uint8_t action)
+{
+    hostReset();
+    swTimerInit();
+    callsA = callsB = callsC = 0;
+    actionA = action;
+
+    idA = swTimerCreate(callbackA);
+    idB = swTimerCreate(callbackB);
+    idC = swTimerCreate(callbackC);
+    swTimerStart(idA, 5, 0);
+    swTimerStart(idB, 5, 0);
+    swTimerStart(idC, 5, 5);
+}
+
+/*
+ *@fn        -   testBasic
+ *
+ *@brief     -   Function to check one-shot, periodic and multi-round expiry ticks
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void testBasic(void)
+{
+    setup(ACTION_NONE);
+    swTimerStart(idB, 3 * SWTIMER_SLOTS + 2, 0);
+
+    ticks(4);
+    CHECK_EQ(callsA, 0);
+    ticks(1);
+    CHECK_EQ(callsA, 1);
+    CHECK_EQ(callsC, 1);
+    CHECK_EQ(swTimerActive(idA), 0);
+    CHECK_EQ(swTimerActive(idC), 1);
+
+    ticks(3 * SWTIMER_SLOTS + 2 - 5 - 1);
+    CHECK_EQ(callsB, 0);
+    ticks(1);
+    CHECK_EQ(callsB, 1);
+    CHECK_EQ(callsA, 1);
+    CHECK_EQ(callsC, (3 * SWTIMER_SLOTS + 2) / 5);
+}
+
+/*
+ *@fn        -   testRestartInCallback
+ *
+ *@brief     -   Function to check that restarting a timer due in the same tick keeps the rest
+ *               of the expired list, the periodic C must survive
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void testRestartInCallback(void)
+{
+    setup(ACTION_RESTART);
+
+    ticks(5);
+    CHECK_EQ(callsA, 1);
+    CHECK_EQ(callsB, 0); // restarted before its callback ran
+    CHECK_EQ(callsC, 1);
+    CHECK_EQ(swTimerActive(idB), 1);
+    CHECK_EQ(swTimerActive(idC), 1);
+
+    ticks(3);
+    CHECK_EQ(callsB, 1);
+    ticks(2);
+    CHECK_EQ(callsC, 2);
+    ticks(50);
+    CHECK_EQ(callsC, 12);
+    CHECK_EQ(callsB, 1);
+}
+
+/*
+ *@fn        -   testStopAndDeleteInCallback
+ *
+ *@brief     -   Function to check that stopping or deleting a timer due in the same tick
+ *               cancels its callback and leaves the others alone
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void testStopAndDeleteInCallback(void)
+{
+    setup(ACTION_STOP);
+    ticks(10);
+    CHECK_EQ(callsA, 1);
+    CHECK_EQ(callsB, 0);
+    CHECK_EQ(callsC, 2);
+
+    setup(ACTION_DELETE);
+    ticks(10);
+    CHECK_EQ(callsA, 1);
+    CHECK_EQ(callsB, 0);
+    CHECK_EQ(callsC, 2);
+    CHECK_EQ(swTimerCreate(callbackB), idB); // B went back to the pool
+}
+
+int main(void)
+{
+    testBasic();
+    testRestartInCallback();
+    testStopAndDeleteInCallback();
+
+    return TEST_RESULT();
+}
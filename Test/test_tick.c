@@ -0,0 +1,77 @@
+/*
+ * test_tick.c
+ * Description: Host test of the system tick period on a crystal whose tick is not a whole number
+ *              of timer counts. Built with -DCLOCK_SOURCE=11059200UL, where a 1 ms tick is 921.6
+ *              counts. Over 10 s of machine cycles the tick must not lose a single millisecond.
+ *              Covers the default Timer 2 tick, TICK_T0_FIXUP is tuned for the target, not the host.
+ *              Also checks that reading the time before tickInit() leaves the tick ISR off.
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+// Library for the check macros
+#include "test.h"
+
+// Library under test
+#include "at89s52_tick.h"
+
+/* Machine cycles in 10 s */
+#define TEN_SECONDS (CLOCK_SOURCE / 12UL * 10UL)
+
+/*
+ *@fn        -   testLongRun
+ *
+ *@brief     -   Function to check the tick count and millis() after 10 s
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void testLongRun(void)
+{
+    uint32_t ms, end;
+
+    hostReset();
+    hostAttachIsr(TIMER2_VECTOR, tickIsr);
+    tickInit();
+
+    // The ISR's own register accesses advance the clock too, so run to a cycle count
+    end = hostCycles() + TEN_SECONDS;
+    while (hostCycles() < end)
+    {
+        hostStep(1);
+    }
+    ms = millis();
+    CHECK_EQ(ms, 10000);
+    CHECK_EQ(tickCount, 10000);
+}
+
+/*
+ *@fn        -   testReadBeforeInit
+ *
+ *@brief     -   Function to check that millis() and micros() keep the tick interrupt disabled
+ *               when the tick was never started
+ *
+ *@param[1]  -   void
+ *
+ *return     -   void
+ */
+static void testReadBeforeInit(void)
+{
+    hostReset();
+    EA = 1;
+
+    (void)millis();
+    CHECK_EQ(TICK_ET, 0);
+    (void)micros();
+    CHECK_EQ(TICK_ET, 0);
+}
+
+int main(void)
+{
+    testReadBeforeInit();
+    testLongRun();
+
+    return TEST_RESULT();
+}
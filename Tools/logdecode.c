@@ -0,0 +1,271 @@
+/*
+ * logdecode.c
+ * Description: Host decoder for the deferred binary log of at89s52_log.c. Reads the raw UART
+ *              byte stream from a file or stdin and prints one line per record, rebuilt from
+ *              the same format table the firmware was built with.
+ *              Build: cc -I../Header -o logdecode logdecode.c
+ *              Use:   logdecode /dev/ttyUSB0   or   logdecode < capture.bin
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+/* Keep in step with at89s52_log.h, the firmware headers are not host buildable */
+#ifndef LOG_FORMAT_TABLE
+#define LOG_FORMAT_TABLE "at89s52_log_formats.h"
+#endif
+#define LOG_SYNC        0xA5
+#define LOG_MAX_ARGS    16
+
+static const char *const formats[] =
+{
+#define LOG_FORMAT(name, fmt) fmt,
+#include LOG_FORMAT_TABLE
+#undef LOG_FORMAT
+};
+
+static const char *const names[] =
+{
+#define LOG_FORMAT(name, fmt) #name,
+#include LOG_FORMAT_TABLE
+#undef LOG_FORMAT
+};
+
+#define FORMAT_COUNT (sizeof(formats) / sizeof(formats[0]))
+
+/* Bytes handed back after a false sync, ungetc only guarantees one */
+static uint8_t pushback[8];
+static unsigned pushed;
+
+static int readByte(FILE *in)
+{
+    return pushed ? pushback[--pushed] : fgetc(in);
+}
+
+static int readBytes(FILE *in, uint8_t *buf, unsigned len)
+{
+    unsigned i;
+    int c;
+
+    for (i = 0; i < len; i++)
+    {
+        if ((c = readByte(in)) == EOF)
+        {
+            return 0;
+        }
+        buf[i] = (uint8_t)c;
+    }
+    return 1;
+}
+
+/*
+ *@fn        -   printRecord
+ *
+ *@brief     -   Function to print one record, each conversion takes 2 argument bytes, 4 with l
+ *
+ *@param[1]  -   Format string
+ *@param[2]  -   Argument bytes
+ *@param[3]  -   Number of argument bytes
+ *
+ *return     -   int, 0 if the arguments did not match the format
+ */
+static int printRecord(const char *fmt, const uint8_t *args, unsigned len)
+{
+    unsigned pos = 0;
+
+    while (*fmt)
+    {
+        char spec[16];
+        unsigned n = 0;
+        unsigned size = 2;
+        int precision = -1;
+        uint32_t raw;
+        char conv;
+
+        if (*fmt != '%')
+        {
+            putchar(*fmt++);
+            continue;
+        }
+        fmt++;
+        if (*fmt == '%')
+        {
+            putchar(*fmt++);
+            continue;
+        }
+
+        // Flags and width pass through to printf, precision only matters for %k
+        spec[n++] = '%';
+        while ((*fmt == '-' || *fmt == '0' || (*fmt >= '1' && *fmt <= '9')) && n < sizeof(spec) - 4)
+        {
+            spec[n++] = *fmt++;
+        }
+        while (*fmt >= '0' && *fmt <= '9' && n < sizeof(spec) - 4)
+        {
+            spec[n++] = *fmt++;
+        }
+        if (*fmt == '.')
+        {
+            precision = 0;
+            fmt++;
+            while (*fmt >= '0' && *fmt <= '9')
+            {
+                precision = precision * 10 + (*fmt++ - '0');
+            }
+        }
+        if (*fmt == 'l')
+        {
+            size = 4;
+            fmt++;
+        }
+        conv = *fmt;
+        if (conv == '\0')
+        {
+            break;
+        }
+        fmt++;
+
+        if (conv == 's')
+        {
+            // Strings stay on the target, the record carries nothing for them
+            fputs("<s>", stdout);
+            continue;
+        }
+        if (pos + size > len)
+        {
+            return 0;
+        }
+        raw = args[pos] | ((uint32_t)args[pos + 1] << 8);
+        if (size == 4)
+        {
+            raw |= ((uint32_t)args[pos + 2] << 16) | ((uint32_t)args[pos + 3] << 24);
+        }
+        pos += size;
+
+        switch (conv)
+        {
+        case 'd':
+        case 'i':
+        case 'k':
+        {
+            int32_t value = (size == 4) ? (int32_t)raw : (int16_t)raw;
+
+            if (conv == 'k' && precision > 0)
+            {
+                // Fixed point, precision digits after the point as formatPrint prints it
+                uint32_t scale = 1;
+                uint32_t mag = (value < 0) ? (uint32_t)-(int64_t)value : (uint32_t)value;
+                int i;
+
+                for (i = 0; i < precision; i++)
+                {
+                    scale *= 10;
+                }
+                printf("%s%lu.%0*lu", (value < 0) ? "-" : "", (unsigned long)(mag / scale),
+                       precision, (unsigned long)(mag % scale));
+                break;
+            }
+            spec[n++] = 'l';
+            spec[n++] = 'd';
+            spec[n] = '\0';
+            printf(spec, (long)value);
+            break;
+        }
+        case 'u':
+        case 'x':
+        case 'X':
+            spec[n++] = 'l';
+            spec[n++] = conv;
+            spec[n] = '\0';
+            printf(spec, (unsigned long)((size == 4) ? raw : (raw & 0xFFFF)));
+            break;
+        case 'c':
+            putchar((int)(raw & 0xFF));
+            break;
+        default:
+            printf("<%%%c>", conv);
+            break;
+        }
+    }
+
+    return pos == len;
+}
+
+int main(int argc, char **argv)
+{
+    FILE *in = stdin;
+    uint8_t header[4];
+    uint8_t args[LOG_MAX_ARGS];
+    uint32_t stamp = 0;
+    uint16_t last = 0;
+    unsigned long skipped = 0;
+    int c;
+
+    if (argc > 2 || (argc == 2 && strcmp(argv[1], "-h") == 0))
+    {
+        fprintf(stderr, "usage: %s [capture file or serial device]\n", argv[0]);
+        return 2;
+    }
+    if (argc == 2 && (in = fopen(argv[1], "rb")) == NULL)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+
+    while ((c = readByte(in)) != EOF)
+    {
+        uint16_t now;
+
+        if (c != LOG_SYNC)
+        {
+            skipped++;
+            continue;
+        }
+        if (!readBytes(in, header, sizeof(header)))
+        {
+            break;
+        }
+        if (header[0] >= FORMAT_COUNT || header[1] > LOG_MAX_ARGS)
+        {
+            // Not a record start, look for the next sync byte
+            skipped++;
+            pushback[pushed++] = header[3];
+            pushback[pushed++] = header[2];
+            pushback[pushed++] = header[1];
+            pushback[pushed++] = header[0];
+            continue;
+        }
+        if (!readBytes(in, args, header[1]))
+        {
+            break;
+        }
+
+        // 16 bit millisecond stamps, unwrap assuming records come at least every 65 s
+        now = header[2] | (header[3] << 8);
+        stamp += (uint16_t)(now - last);
+        last = now;
+
+        printf("%10lu.%03lu %-10s ", (unsigned long)(stamp / 1000), (unsigned long)(stamp % 1000),
+               names[header[0]]);
+        if (!printRecord(formats[header[0]], args, header[1]))
+        {
+            printf(" <%u argument bytes do not match>", header[1]);
+        }
+        putchar('\n');
+        fflush(stdout);
+    }
+
+    if (skipped)
+    {
+        fprintf(stderr, "%lu bytes skipped while resyncing\n", skipped);
+    }
+    if (in != stdin)
+    {
+        fclose(in);
+    }
+    return 0;
+}
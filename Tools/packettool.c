@@ -0,0 +1,224 @@
+/*
+ * packettool.c
+ * Description: Host encoder and decoder for the frames of at89s52_packet.c, COBS framing
+ *              over payload | CRC-16/CCITT-FALSE big endian, 0x00 delimited.
+ *              Build: cc -o packettool packettool.c
+ *              Use:   packettool encode < payload.bin > /dev/ttyUSB0
+ *                     packettool decode < /dev/ttyUSB0
+ * Author:      Jashuva
+ * Date:        October 17, 2026
+ * License:     Open source
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#define MAX_PAYLOAD 253
+#define MAX_FRAME   (MAX_PAYLOAD + 2)
+
+/*
+ *@fn        -   crc16
+ *
+ *@brief     -   Function to run the CRC-16/CCITT-FALSE bit by bit, independent of the target table
+ *
+ *@param[1]  -   Data reference
+ *@param[2]  -   Number of bytes
+ *
+ *return     -   uint16_t
+ */
+static uint16_t crc16(const uint8_t *data, size_t len)
+{
+    uint16_t crc = 0xFFFF;
+    int i;
+
+    while (len--)
+    {
+        crc ^= (uint16_t)(*data++ << 8);
+        for (i = 0; i < 8; i++)
+        {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+/*
+ *@fn        -   encode
+ *
+ *@brief     -   Function to write one frame for the payload read from stdin
+ *
+ *@param[1]  -   void
+ *
+ *return     -   int, process exit code
+ */
+static int encode(void)
+{
+    uint8_t frame[MAX_FRAME + 1];
+    uint8_t out[MAX_FRAME + 4];
+    size_t len = fread(frame, 1, sizeof(frame), stdin);
+    size_t code = 0;
+    size_t n = 1;
+    size_t i;
+    uint16_t crc;
+
+    if (len > MAX_PAYLOAD)
+    {
+        fprintf(stderr, "payload longer than %d bytes\n", MAX_PAYLOAD);
+        return 1;
+    }
+    crc = crc16(frame, len);
+    frame[len++] = (uint8_t)(crc >> 8);
+    frame[len++] = (uint8_t)crc;
+
+    for (i = 0; i < len; i++)
+    {
+        if (frame[i] == 0)
+        {
+            out[code] = (uint8_t)(n - code);
+            code = n++;
+            continue;
+        }
+        out[n++] = frame[i];
+        if (n - code == 0xFF && i + 1 < len)
+        {
+            out[code] = 0xFF;
+            code = n++;
+        }
+    }
+    out[code] = (uint8_t)(n - code);
+    out[n++] = 0x00;
+
+    fwrite(out, 1, n, stdout);
+    return 0;
+}
+
+/*
+ *@fn        -   decodeFrame
+ *
+ *@brief     -   Function to undo COBS and check the CRC of one frame without its delimiter
+ *
+ *@param[1]  -   Encoded bytes
+ *@param[2]  -   Number of encoded bytes
+ *@param[3]  -   Decoded output, MAX_FRAME bytes
+ *
+ *return     -   long, payload length or -1 on a bad frame
+ */
+static long decodeFrame(const uint8_t *in, size_t len, uint8_t *out)
+{
+    size_t i = 0;
+    size_t n = 0;
+
+    while (i < len)
+    {
+        uint8_t code = in[i++];
+        uint8_t k;
+
+        if (code == 0 || i + code - 1 > len)
+        {
+            return -1;
+        }
+        for (k = 1; k < code; k++)
+        {
+            if (n == MAX_FRAME)
+            {
+                return -1;
+            }
+            out[n++] = in[i++];
+        }
+        if (code != 0xFF && i < len)
+        {
+            if (n == MAX_FRAME)
+            {
+                return -1;
+            }
+            out[n++] = 0;
+        }
+    }
+
+    // The CRC run over its own bytes leaves 0
+    if (n < 2 || crc16(out, n) != 0)
+    {
+        return -1;
+    }
+
+    return (long)n - 2;
+}
+
+/*
+ *@fn        -   decode
+ *
+ *@brief     -   Function to print every good frame on stdin as a hex line
+ *
+ *@param[1]  -   void
+ *
+ *return     -   int, process exit code
+ */
+static int decode(void)
+{
+    uint8_t in[2 * MAX_FRAME];
+    uint8_t out[MAX_FRAME];
+    unsigned long good = 0;
+    unsigned long bad = 0;
+    size_t len = 0;
+    int overflow = 0;
+    int c;
+
+    while ((c = getchar()) != EOF)
+    {
+        long n;
+        long i;
+
+        if (c != 0)
+        {
+            if (len < sizeof(in))
+            {
+                in[len++] = (uint8_t)c;
+            }
+            else
+            {
+                overflow = 1;
+            }
+            continue;
+        }
+        if (len == 0)
+        {
+            continue;
+        }
+
+        n = overflow ? -1 : decodeFrame(in, len, out);
+        len = 0;
+        overflow = 0;
+        if (n < 0)
+        {
+            bad++;
+            continue;
+        }
+        good++;
+        for (i = 0; i < n; i++)
+        {
+            printf("%02X%s", out[i], (i + 1 < n) ? " " : "");
+        }
+        putchar('\n');
+        fflush(stdout);
+    }
+
+    fprintf(stderr, "%lu frames, %lu bad\n", good, bad);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc == 2 && strcmp(argv[1], "encode") == 0)
+    {
+        return encode();
+    }
+    if (argc == 2 && strcmp(argv[1], "decode") == 0)
+    {
+        return decode();
+    }
+
+    fprintf(stderr, "usage: %s encode|decode\n", argv[0]);
+    return 2;
+}